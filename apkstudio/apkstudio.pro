@@ -5,16 +5,26 @@ DEFINES += APP_REV_LONG=\\\"$$GIT_REV_LONG\\\"
 
 HEADERS += \
     include/adb.h \
+    include/apkdock.h \
     include/apktool.h \
+    include/axmldecoder.h \
+    include/buildmanifest.h \
     include/buildrunnable.h \
+    include/canceltoken.h \
     include/coder.h \
     include/coderhighlighter.h \
     include/coderhighlighterdefinition.h \
     include/coderhighlightertheme.h \
+    include/coderhighlighterworker.h \
     include/codersidebar.h \
+    include/codertokenizer.h \
     include/consoledock.h \
     include/constants.h \
+    include/decodebatch.h \
+    include/decodecache.h \
     include/decoderunnable.h \
+    include/dexreader.h \
+    include/dexsummary.h \
     include/dialog.h \
     include/editortabs.h \
     include/fileutils.h \
@@ -22,26 +32,45 @@ HEADERS += \
     include/flickcharm.h \
     include/ide.h \
     include/installrunnable.h \
+    include/jobsdock.h \
     include/java.h \
+    include/javaworker.h \
+    include/lineindex.h \
     include/macros.h \
     include/menubar.h \
     include/pathutils.h \
-    include/pleasewait.h \
     include/preferences.h \
     include/preopenapk.h \
+    include/preopenapks.h \
     include/process.h \
     include/projectdock.h \
+    include/projectlister.h \
+    include/projectmodel.h \
+    include/projectscanner.h \
+    include/projectsnapshot.h \
     include/qrc.h \
+    include/resourcetable.h \
     include/runnable.h \
     include/runner.h \
+    include/searchdock.h \
+    include/searchwalker.h \
+    include/searchworker.h \
     include/settingseditor.h \
     include/signexportapk.h \
     include/signrunnable.h \
+    include/smaliindex.h \
+    include/smaliindexer.h \
     include/statusbar.h \
+    include/stringpool.h \
     include/textutils.h \
+    include/textviewer.h \
     include/toolbar.h \
+    include/trigramindex.h \
+    include/trigramindexer.h \
+    include/versionprobe.h \
     include/viewer.h \
     include/widgetbar.h \
+    include/zipreader.h \
     include/uberapksigner.h
 
 OTHER_FILES += \
@@ -64,6 +93,9 @@ OTHER_FILES += \
 
 QT += core gui widgets
 
+unix: LIBS += -lz
+win32: INCLUDEPATH += $$[QT_INSTALL_HEADERS]/QtZlib
+
 win32:RC_FILE = res/win32.rc
 
 RESOURCES += \
@@ -71,15 +103,24 @@ RESOURCES += \
 
 SOURCES += \
     src/adb.cpp \
+    src/apkdock.cpp \
     src/apktool.cpp \
+    src/axmldecoder.cpp \
+    src/buildmanifest.cpp \
     src/buildrunnable.cpp \
     src/coder.cpp \
     src/coderhighlighter.cpp \
     src/coderhighlighterdefinition.cpp \
     src/coderhighlightertheme.cpp \
+    src/coderhighlighterworker.cpp \
     src/codersidebar.cpp \
+    src/codertokenizer.cpp \
     src/consoledock.cpp \
+    src/decodebatch.cpp \
+    src/decodecache.cpp \
     src/decoderunnable.cpp \
+    src/dexreader.cpp \
+    src/dexsummary.cpp \
     src/dialog.cpp \
     src/editortabs.cpp \
     src/fileutils.cpp \
@@ -87,26 +128,45 @@ SOURCES += \
     src/flickcharm.cpp \
     src/ide.cpp \
     src/installrunnable.cpp \
+    src/jobsdock.cpp \
     src/java.cpp \
+    src/javaworker.cpp \
+    src/lineindex.cpp \
     src/main.cpp \
     src/menubar.cpp \
     src/pathutils.cpp \
-    src/pleasewait.cpp \
     src/preferences.cpp \
     src/preopenapk.cpp \
+    src/preopenapks.cpp \
     src/process.cpp \
     src/projectdock.cpp \
+    src/projectlister.cpp \
+    src/projectmodel.cpp \
+    src/projectscanner.cpp \
+    src/projectsnapshot.cpp \
     src/qrc.cpp \
+    src/resourcetable.cpp \
     src/runnable.cpp \
     src/runner.cpp \
+    src/searchdock.cpp \
+    src/searchwalker.cpp \
+    src/searchworker.cpp \
     src/settingseditor.cpp \
     src/signexportapk.cpp \
     src/signrunnable.cpp \
+    src/smaliindex.cpp \
+    src/smaliindexer.cpp \
     src/statusbar.cpp \
+    src/stringpool.cpp \
     src/textutils.cpp \
+    src/textviewer.cpp \
     src/toolbar.cpp \
+    src/trigramindex.cpp \
+    src/trigramindexer.cpp \
+    src/versionprobe.cpp \
     src/viewer.cpp \
     src/widgetbar.cpp \
+    src/zipreader.cpp \
     src/uberapksigner.cpp
 
 TARGET = apkstudio
@@ -0,0 +1,48 @@
+#ifndef APKDOCK_H
+#define APKDOCK_H
+
+#include <QDockWidget>
+#include <QFileIconProvider>
+#include <QTreeWidget>
+#include "zipreader.h"
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Contents of an APK read straight from its central directory, so it
+ * can be looked into before, or instead of, decoding it. Entries are inflated
+ * to a scratch folder when opened.
+ */
+class ApkDock : public QDockWidget
+{
+    Q_OBJECT
+private:
+    APP_CONNECTIONS_LIST
+    QString _apk;
+    QFileIconProvider _provider;
+    ZipReader _reader;
+    QTreeWidget *_tree;
+private:
+    QString extract(const int entry);
+    QString scratch() const;
+public:
+    enum ApkDockRole
+    {
+        RoleEntry = Qt::UserRole + 1
+    };
+public:
+    explicit ApkDock(QWidget *parent = 0);
+    ~ApkDock();
+private Q_SLOTS:
+    void onApkBrowse(const QString &apk);
+    void onContextMenuRequested(const QPoint &point);
+    void onItemActivated(QTreeWidgetItem *item);
+Q_SIGNALS:
+    void apkDecode(QString);
+    void fileOpen(QString);
+};
+
+APP_NAMESPACE_END
+
+#endif // APKDOCK_H
@@ -15,12 +15,13 @@ private:
 private:
     explicit ApkTool(QObject *parent = 0);
 public:
-    Result build(const QString &project, const QString &apk);
+    Result build(const QString &project, const QString &apk, const bool force);
     Result decode(const QString &apk, const QString &project, const QString &framework, const bool sources, const bool resources);
     inline Result exec(const QString &arg) { return exec(QStringList(arg)); }
     Result exec(const QStringList &args = QStringList());
     static ApkTool *get();
     QString getVersion();
+    inline QString path() const { return _jar; }
 };
 
 APP_NAMESPACE_END
@@ -0,0 +1,38 @@
+#ifndef AXMLDECODER_H
+#define AXMLDECODER_H
+
+#include <QString>
+#include "stringpool.h"
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Turns Android's binary XML (compiled manifests and res/ layouts) back
+ * into text. Works in place over the given bytes: strings are read from the
+ * pool as they are needed, nothing is copied up front.
+ *
+ * Resource references come out as raw ids, e.g. "@0x7f0b0001"; names would
+ * need resources.arsc.
+ */
+class AxmlDecoder
+{
+private:
+    const uchar *_data;
+    const uchar *_resources;
+    int _resourceCount;
+    qint64 _size;
+    StringPool _strings;
+private:
+    QString attributeName(const quint32 name) const;
+    QString string(const quint32 i) const;
+public:
+    explicit AxmlDecoder(const uchar *data, const qint64 size);
+    QString toXml();
+    static bool isBinary(const uchar *data, const qint64 size);
+    static QString value(const quint8 type, const quint32 data, const StringPool &strings);
+};
+
+APP_NAMESPACE_END
+
+#endif // AXMLDECODER_H
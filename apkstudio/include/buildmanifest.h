@@ -0,0 +1,44 @@
+#ifndef BUILDMANIFEST_H
+#define BUILDMANIFEST_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Content hashes of the files apktool builds a project from, kept next
+ * to apktool.yml. A file keeps its hash while its modification time and size
+ * are unchanged, so only new, edited or hinted files are read again.
+ *
+ * Files are grouped by the top level entry they live under ("smali_classes2",
+ * "res", "AndroidManifest.xml" and so on), which is the unit apktool rebuilds.
+ * Groups of a build that did not finish stay pending until one does.
+ */
+class BuildManifest
+{
+private:
+    struct Entry
+    {
+        QByteArray hash;
+        qint64 modified;
+        qint64 size;
+    };
+    QHash<QString, Entry> _entries;
+    QSet<QString> _pending;
+    QString _project;
+public:
+    explicit BuildManifest(const QString &project);
+    bool load();
+    bool save();
+    inline void setPending(const QSet<QString> &groups) { _pending = groups; }
+    QSet<QString> update(const QSet<QString> &hints);
+    static QString group(const QString &path);
+};
+
+APP_NAMESPACE_END
+
+#endif // BUILDMANIFEST_H
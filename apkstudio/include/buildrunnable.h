@@ -1,6 +1,7 @@
 #ifndef BUILDRUNNABLE_H
 #define BUILDRUNNABLE_H
 
+#include <QSet>
 #include "macros.h"
 #include "runnable.h"
 
@@ -11,10 +12,14 @@ class BuildRunnable : public Runnable
     Q_OBJECT
 private:
     QString _apk;
+    QSet<QString> _hints;
     QString _project;
+private:
+    bool invalidate(const QSet<QString> &groups);
+protected:
+    bool execute();
 public:
-    explicit BuildRunnable(const QString &project, const QString &apk, QObject *parent);
-    void run();
+    explicit BuildRunnable(const QString &project, const QString &apk, const QSet<QString> &hints, QObject *parent);
 Q_SIGNALS:
     void buildFailure(const QString &project);
     void buildSuccess(const QString &apk);
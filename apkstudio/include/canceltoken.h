@@ -0,0 +1,18 @@
+#ifndef CANCELTOKEN_H
+#define CANCELTOKEN_H
+
+#include <QAtomicInt>
+#include <QSharedPointer>
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Shared by everything one piece of work starts, set to non-zero to
+ * cancel them all.
+ */
+typedef QSharedPointer<QAtomicInt> CancelToken;
+
+APP_NAMESPACE_END
+
+#endif // CANCELTOKEN_H
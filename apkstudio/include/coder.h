@@ -19,9 +19,13 @@ class Coder : public QPlainTextEdit
     Q_OBJECT
 private:
     APP_CONNECTIONS_LIST
+    QString _loading;
+    int _loadingOffset;
     CoderSidebar *_sidebar;
     bool _spacesForTabs;
     int _tabStopWidth;
+    int _viewportFirst;
+    int _viewportLast;
 private:
     QString addIndent(QString text, int count);
     int indentSize(const QString &text);
@@ -33,6 +37,7 @@ private Q_SLOTS:
     void onMoveLineUp();
     void onCursorPositionChanged();
     void onInit();
+    void onLoadMore();
     void onUpdateRequest(const QRect &rect, const int column);
     void onUpdateMargins(const int count);
     void onTransformToLower();
@@ -70,14 +75,25 @@ public:
     }
     void gotoLineEnd();
     void gotoLineStart();
+    void load(const QString &text);
     void setCompleter(QCompleter *completer);
     void setCurrentRow(const int row);
     void setFont(const QFont &font);
     void setTabStopWidth(const int width);
+    inline int viewportFirst() const
+    {
+        return _viewportFirst;
+    }
+    inline int viewportLast() const
+    {
+        return _viewportLast;
+    }
     ~Coder();
 Q_SIGNALS:
     void fileDropped(const QString &path);
+    void loaded();
     void tooltipRequested(const QPoint &position);
+    void viewportChanged(const int first, const int last);
 };
 
 APP_NAMESPACE_END
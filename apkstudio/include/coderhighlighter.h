@@ -1,23 +1,68 @@
 #ifndef CODERHIGHLIGHTER_H
 #define CODERHIGHLIGHTER_H
 
+#include <QPointer>
 #include <QSyntaxHighlighter>
-#include "coderhighlighterdefinition.h"
-#include "coderhighlightertheme.h"
+#include <QTextBlockUserData>
+#include "coderhighlighterworker.h"
+#include "codertokenizer.h"
+#include "constants.h"
 #include "macros.h"
 
 APP_NAMESPACE_START
 
+struct CoderHighlighterBlockData : public QTextBlockUserData
+{
+    int previous;
+    int revision;
+    int state;
+    CoderTokenList tokens;
+};
+
 class CoderHighlighter : public QSyntaxHighlighter
 {
+    Q_OBJECT
 private:
-    CoderHighlighterDefinition *_definition;
-    bool _showWhitespaces;
-    CoderHighlighterTheme *_theme;
+    int _activeFirst;
+    bool _activeGuessed;
+    int _activeLast;
+    int _activePrevious;
+    QVector<int> _checkpoints;
+    int _edited;
+    int _generation;
+    bool _lazy;
+    int _pending;
+    bool _refreshing;
+    bool _restarting;
+    CoderTokenList _tokens;
+    const CoderTokenizer *_tokenizer;
+    int _viewportFirst;
+    int _viewportLast;
+    QPointer<CoderHighlighterWorker> _worker;
+#ifdef HIGHLIGHTER_BENCHMARK
+    qint64 _blocks;
+    qint64 _elapsed;
+#endif
+private:
+    void apply(const CoderTokenList &tokens);
+    void highlightCached(const QString &text);
+    void highlightVisible(const QString &text);
+    void invalidate(const int block);
+    void refresh(const bool force);
+    void start(const int block);
+    int stateAt(const int block, bool &guessed) const;
+private Q_SLOTS:
+    void onBlockCountChanged(const int count);
+    void onChunkReady(const CoderHighlighterChunk &chunk);
+    void onContentsChange(const int position, const int removed, const int added);
+    void onRestart();
+    void onWorkerFinished(const int generation);
 public:
     explicit CoderHighlighter(const QString &definition, const QString &theme, QTextDocument *document = 0);
-    ~CoderHighlighter();
     void highlightBlock(const QString &text);
+    ~CoderHighlighter();
+public Q_SLOTS:
+    void setViewport(const int first, const int last);
 };
 
 APP_NAMESPACE_END
@@ -4,14 +4,24 @@
 #include "macros.h"
 #include <QMap>
 #include <QRegularExpression>
+#include <QTextCharFormat>
 
 APP_NAMESPACE_START
 
+class CoderHighlighterTheme;
+
 struct CoderHighlighterDefinitionEntry
 {
     bool multiline;
     QString regex;
     QString style;
+    // Compiled : Begin
+    QRegularExpression begin;
+    QRegularExpression end;
+    QTextCharFormat format;
+    QRegularExpression pattern;
+    // Compiled : End
+    CoderHighlighterDefinitionEntry() : multiline(false) {}
 };
 
 typedef QList<CoderHighlighterDefinitionEntry> CoderHighlighterDefinitionEntryList;
@@ -19,8 +29,10 @@ typedef QList<CoderHighlighterDefinitionEntry> CoderHighlighterDefinitionEntryLi
 class CoderHighlighterDefinition
 {
 private:
+    static QMap<QString, CoderHighlighterDefinition *> _cache;
     CoderHighlighterDefinitionEntryList _entries;
 private:
+    void compile(const CoderHighlighterTheme &theme);
     CoderHighlighterDefinitionEntry parse(const QString &key, const QString &value) const;
 public:
     CoderHighlighterDefinition(const QString &path);
@@ -28,7 +40,8 @@ public:
     CoderHighlighterDefinition &operator <<(const CoderHighlighterDefinitionEntry &entry);
     CoderHighlighterDefinition &operator <<(const CoderHighlighterDefinitionEntryList &entries);
     CoderHighlighterDefinition &operator <<(const CoderHighlighterDefinition &definition);
-    inline CoderHighlighterDefinitionEntryList entries() const { return _entries; }
+    inline const CoderHighlighterDefinitionEntryList &entries() const { return _entries; }
+    static const CoderHighlighterDefinition *get(const QString &definition, const QString &theme);
 };
 
 APP_NAMESPACE_END
@@ -17,7 +17,7 @@ private:
     QTextCharFormat parse(const QString &style);
 public:
     CoderHighlighterTheme(const QString &path);
-    inline CoderHighlighterThemeStyles styles() const { return _styles; }
+    inline const CoderHighlighterThemeStyles &styles() const { return _styles; }
 };
 
 APP_NAMESPACE_END
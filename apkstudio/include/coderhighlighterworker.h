@@ -0,0 +1,58 @@
+#ifndef CODERHIGHLIGHTERWORKER_H
+#define CODERHIGHLIGHTERWORKER_H
+
+#include <QAtomicInt>
+#include <QObject>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QStringList>
+#include "codertokenizer.h"
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+struct CoderHighlighterChunk
+{
+    int first;
+    int generation;
+    bool guessed;
+    int previous;
+    QVector<int> revisions;
+    QVector<int> states;
+    QVector<CoderTokenList> tokens;
+};
+
+class CoderHighlighterWorker : public QObject, public QRunnable
+{
+    Q_OBJECT
+private:
+    QAtomicInt _cancelled;
+    QSemaphore _credits;
+    int _first;
+    int _generation;
+    QStringList _lines;
+    QAtomicInt _priorityFirst;
+    QAtomicInt _priorityLast;
+    QVector<int> _revisions;
+    int _state;
+    const CoderTokenizer *_tokenizer;
+    bool _tokens;
+private:
+    bool acquire();
+    CoderHighlighterChunk tokenize(const int from, const int to, int &state, const bool guessed) const;
+public:
+    explicit CoderHighlighterWorker(const CoderTokenizer *tokenizer, const int generation, const int first, const int state, const QStringList &lines, const QVector<int> &revisions, const bool tokens = true);
+    void cancel();
+    void prioritize(const int first, const int last);
+    inline void release() { _credits.release(); }
+    void run();
+Q_SIGNALS:
+    void chunkReady(const CoderHighlighterChunk &chunk);
+    void finished(const int generation);
+};
+
+APP_NAMESPACE_END
+
+Q_DECLARE_METATYPE(APP_NAMESPACE::CoderHighlighterChunk)
+
+#endif // CODERHIGHLIGHTERWORKER_H
@@ -0,0 +1,58 @@
+#ifndef CODERTOKENIZER_H
+#define CODERTOKENIZER_H
+
+#include <QBitArray>
+#include <QMap>
+#include <QRegularExpression>
+#include <QVector>
+#include "coderhighlighterdefinition.h"
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+struct CoderToken
+{
+    int start;
+    int length;
+    int entry;
+};
+
+typedef QVector<CoderToken> CoderTokenList;
+
+/**
+ * @brief Single pass over a block using one alternation of all entries. The
+ * longest match wins, ties go to the entry declared last. State is 0, or the
+ * index of the open multiline entry plus one.
+ *
+ * Only alternatives that can start with the same character as the one that
+ * matched are tried again for a longer match, so the cost per token does not
+ * grow with the number of entries.
+ */
+class CoderTokenizer
+{
+private:
+    struct Alternative
+    {
+        int entry;
+        QBitArray first;
+        int group;
+        QVector<int> overlaps;
+    };
+    static QMap<const CoderHighlighterDefinition *, CoderTokenizer *> _cache;
+    QVector<Alternative> _alternatives;
+    QRegularExpression _combined;
+    const CoderHighlighterDefinition *_definition;
+private:
+    int tokenizeEach(const QString &text, const int state, CoderTokenList &tokens) const;
+public:
+    explicit CoderTokenizer(const CoderHighlighterDefinition *definition);
+    inline const CoderHighlighterDefinition *definition() const { return _definition; }
+    static const CoderTokenizer *get(const QString &definition, const QString &theme);
+    int tokenize(const QString &text, const int state, CoderTokenList &tokens) const;
+};
+
+APP_NAMESPACE_END
+
+Q_DECLARE_TYPEINFO(APP_NAMESPACE::CoderToken, Q_PRIMITIVE_TYPE);
+
+#endif // CODERTOKENIZER_H
@@ -2,25 +2,54 @@
 #define CONSOLEDOCK_H
 
 #include <QDockWidget>
-#include <QTextEdit>
+#include <QPlainTextEdit>
+#include <QSet>
+#include <QTextCharFormat>
+#include <QTimer>
 #include "process.h"
 #include "macros.h"
 
 APP_NAMESPACE_START
 
+/**
+ * @brief Tool output, appended at most once a frame. The view keeps the last
+ * CONSOLE_MAX_LINES lines and drops older ones as new ones arrive.
+ */
 class ConsoleDock : public QDockWidget
 {
     Q_OBJECT
 private:
-    QTextEdit *_edit;
+    enum LineKind
+    {
+        KindCode,
+        KindCommand,
+        KindError,
+        KindOutput
+    };
+    struct Line
+    {
+        LineKind kind;
+        QString text;
+    };
+    QPlainTextEdit *_edit;
+    QTextCharFormat _formats[4];
+    QVector<Line> _pending;
+    QSet<Process *> _ready;
+    QTimer _timer;
+private:
+    void append(const LineKind kind, const QString &text);
+    void drain(Process *process);
 protected:
     APP_CONNECTIONS_LIST
 public:
     explicit ConsoleDock(QWidget *parent = 0);
     ~ConsoleDock();
+private Q_SLOTS:
+    void onFrame();
 public Q_SLOTS:
     void onExecuted(const Process::Result &result);
     void onExecuting(const QString &command, const QStringList &args);
+    void onOutputReady();
 };
 
 APP_NAMESPACE_END
@@ -4,6 +4,9 @@
 #define APP_NAME "apkstudio/qt5"
 #define APP_ORGANIZATION "vaibhavpandeyvpz"
 
+#define BUILD_MANIFEST_MAGIC "ASBM"
+#define BUILD_MANIFEST_VERSION 1
+
 #define CLI_TIMEOUT 5 * 60 * 1000
 
 #define COLOR_CODE 0x2ad2c9
@@ -11,23 +14,55 @@
 #define COLOR_OUTPUT 0xffffff
 #define COLOR_ERROR 0xfb0a2a
 
+#define CONSOLE_FRAME 16
+#define CONSOLE_MAX_LINES 100000
+
+#define DECODE_CACHE_CHUNK (4 * 1024 * 1024)
+#define DECODE_CACHE_MAX_ENTRIES 32
+
+#define DEX_MAX_REFERENCES 65536
+
 #define EDITOR_EXT_CODER "java|smali|xml|yml|txt|md|SF|properties|clj|MF|crt|json"
 #define EDITOR_EXT_VIEWER "gif|jpg|jpeg|png"
+#define EDITOR_LOAD_CHUNK (1024 * 1024)
 
+#define FILE_APK_SOURCE ".apkstudio.apk"
+#define FILE_BUILD_MANIFEST ".apkstudio.build"
 #define FILE_PREFERENCES "preferences.ini"
+#define FILE_READ_CHUNK (4 * 1024 * 1024)
+#define FILE_TRIGRAM_INDEX ".apkstudio.trigrams"
+#define FILE_VERSIONS "versions.ini"
 
 #define FOLDER_APP ".apkstudio"
+#define FOLDER_DECODED "decoded"
+#define FOLDER_SNAPSHOTS "snapshots"
 #define FOLDER_VENDOR "vendor"
-
+#define FOLDER_WORKER "worker"
+
+#define HIGHLIGHTER_CHECKPOINT_BLOCKS 1000
+#define HIGHLIGHTER_CHUNK_BLOCKS 256
+#define HIGHLIGHTER_CHUNKS_IN_FLIGHT 2
+#define HIGHLIGHTER_LAZY_BLOCKS 20000
+#define HIGHLIGHTER_LAZY_DELAY 500
+#define HIGHLIGHTER_LAZY_KEEP 2000
+#define HIGHLIGHTER_LAZY_MARGIN 100
 #define HIGHLIGHTER_THEME "default.theme"
+#define HIGHLIGHTER_THREADED_BLOCKS 5000
 #define HIGHLIGHTER_STYLE_WHITESPACES "whitespaces"
 
+#define JAVA_WORKER_SOURCE "ApkStudioWorker.java"
+#define JAVA_WORKER_START_TIMEOUT 30000
+
 #define PREF_DEFAULT_JAVA_HEAP 256
+#define PREF_DEFAULT_PARALLEL_JOBS 2
 #define PREF_DEFAULT_TAB_STOP_WIDTH 4
 #define PREF_DEFAULT_TEXT_ENCODING "UTF-8"
+#define PREF_DEFAULT_VIEWER_THRESHOLD 32
 
 #define PREF_DOCKS_STATE "DocksState"
 #define PREF_JAVA_HEAP "JavaHeap"
+#define PREF_JAVA_WORKER "JavaWorker"
+#define PREF_PARALLEL_JOBS "ParallelJobs"
 #define PREF_PREVIOUS_DIR "PreviousDir"
 #define PREF_SESSION_PROJECT "SessionProject"
 #define PREF_SESSION_FILES "SessionFiles"
@@ -40,9 +75,19 @@
 #define PREF_TAB_STOP_WIDTH "TabStopWidth"
 #define PREF_TEXT_ENCODING "TextEncoding"
 #define PREF_VENDOR_PATH "VendorPath"
+#define PREF_VIEWER_THRESHOLD "ViewerThreshold"
 #define PREF_WINDOW_MAXIMIZED "WindowMaximized"
 #define PREF_WINDOW_SIZE "WindowSize"
 
+#define PROCESS_BUFFER_LINES 10000
+#define PROCESS_POLL_INTERVAL 100
+#define PROCESS_RESULT_HEAD 100
+#define PROCESS_RESULT_LINES 1000
+
+#define PROJECT_SNAPSHOT_MAGIC "ASPS"
+#define PROJECT_SNAPSHOT_VERSION 1
+#define PROJECT_WATCH_DELAY 500
+
 #define QRC_FONTS ":/fonts/%1.ttf"
 #define QRC_HIGHLIGHT ":/highlight/%1"
 #define QRC_HTML ":/html/%1.html"
@@ -50,30 +95,59 @@
 #define QRC_IMAGES ":/images/%1.%2"
 #define QRC_LANG ":/lang/"
 #define QRC_STYLES ":/styles/%1.qss"
+#define QRC_WORKER ":/worker/%1"
 
-#define REGEX_LF "[\\r\\n]"
 #define REGEX_ADB_VERSION "^.*(\\d+)\\.(\\d+)\\.(\\d+)$"
 #define REGEX_APKTOOL_VERSION "^(\\d+)\\.(\\d+)\\.(\\d+)$"
 #define REGEX_UBERAPKTOOL_VERSION "^.*(\\d+)\\.(\\d+)\\.(\\d+)$"
 #define REGEX_JAVA_VERSION "^.*\"(\\d+)\\.(\\d+)\\.(\\d+)_(\\d+)\"$"
+#define REGEX_DEX_ENTRY "^classes\\d*\\.dex$"
+#define REGEX_RESOURCE_ID "@?0x([0-9a-fA-F]{8})\\b"
 #define REGEX_THEME_STYLE "\\b([a-z]+)\\:\\s*([0-9a-z#]+)\\b"
 #define REGEX_WHITESPACE "\\s+"
 
+#define RESOURCE_TOOLTIP_CHARS 200
+#define RESOURCE_TOOLTIP_LINES 12
+
+#define RUNNER_RESOURCE_ADB "adb"
+#define RUNNER_RESOURCE_JAVA "java"
+
+#define SEARCH_BATCH_FILES 128
+#define SEARCH_DELAY 300
+#define SEARCH_MAX_FILE_MATCHES 1000
+#define SEARCH_MAX_RESULTS 10000
+#define SEARCH_PREVIEW_CHARS 200
+
+#define TAB_PROPERTY_LINE "GotoLine"
 #define TAB_PROPERTY_PATH "SrcPath"
 
 #define TRANSLATION_CONTEXT "apkstudio"
 
-#define THREADS_MAX 1
+#define TRIGRAM_INDEX_DELAY 2000
+#define TRIGRAM_INDEX_MAGIC "ASTI"
+#define TRIGRAM_INDEX_VERSION 1
+
+#define THREADS_MAX 16
+
+#define VIEWER_LINE_BYTES (16 * 1024)
+#define VIEWER_STATE_CACHE 65536
+#define VIEWER_STATE_ROWS 16
 
 #define URL_CONTRIBUTE "https://github.com/vaibhavpandeyvpz/apkstudio"
 #define URL_DOCUMENTATION "https://forum.xda-developers.com/showpost.php?p=75831837"
 #define URL_ISSUES "https://github.com/vaibhavpandeyvpz/apkstudio/issues"
 #define URL_THANKS "https://forum.xda-developers.com/showthread.php?t=3761033"
 
+#define ZIP_CHUNK (256 * 1024)
+#define ZIP_RESERVE_MAX (256 * 1024 * 1024)
+#define ZIP_RESERVE_RATIO 8
+
 /**
   * @brief Build flags
   */
 // #define NO_NATIVE_DIALOG
+// #define HIGHLIGHTER_BENCHMARK
+// #define LINEINDEX_BENCHMARK
 
 #ifndef LINUX_VENDOR_PATH
 #define LINUX_VENDOR_PATH "/usr/share/apkstudio/vendor"
@@ -0,0 +1,52 @@
+#ifndef DECODEBATCH_H
+#define DECODEBATCH_H
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QVector>
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Decodes many APKs as independent Runner jobs and, once the last one
+ * is done, writes a report of how long each took and which ones failed.
+ */
+class DecodeBatch : public QObject
+{
+    Q_OBJECT
+private:
+    struct Entry
+    {
+        QString apk;
+        qint64 elapsed;
+        QString project;
+        int state;
+    };
+    APP_CONNECTIONS_LIST
+    QVector<Entry> _entries;
+    int _heap;
+    QHash<int, int> _ids;
+    int _parallel;
+    int _pending;
+    QString _report;
+    QDateTime _started;
+    QElapsedTimer _timer;
+private:
+    bool write();
+private Q_SLOTS:
+    void onJobChanged(const int id, const int state);
+public:
+    explicit DecodeBatch(const QString &report, QObject *parent = 0);
+    ~DecodeBatch();
+public:
+    void add(const QString &apk, const QString &project, const QString &framework, const bool sources, const bool resources);
+Q_SIGNALS:
+    void finished(const QString &report, const int succeeded, const int total);
+};
+
+APP_NAMESPACE_END
+
+#endif // DECODEBATCH_H
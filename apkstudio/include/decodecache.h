@@ -0,0 +1,28 @@
+#ifndef DECODECACHE_H
+#define DECODECACHE_H
+
+#include <QString>
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Decoded projects kept under the app folder, addressed by the APK's
+ * bytes and everything else apktool's output depends on: the apktool jar, the
+ * framework tag and the decode flags. Least recently used entries are dropped
+ * once there are more than DECODE_CACHE_MAX_ENTRIES.
+ */
+class DecodeCache
+{
+private:
+    static QString path(const QString &key);
+    static void trim();
+public:
+    static QString key(const QString &apk, const QString &framework, const bool sources, const bool resources);
+    static bool restore(const QString &key, const QString &project);
+    static void store(const QString &key, const QString &project);
+};
+
+APP_NAMESPACE_END
+
+#endif // DECODECACHE_H
@@ -15,9 +15,12 @@ private:
     QString _project;
     bool _resources;
     bool _sources;
+private:
+    void source();
+protected:
+    bool execute();
 public:
     explicit DecodeRunnable(const QString &apk, const QString &project, const QString &framework, const bool sources, const bool resources, QObject *parent = 0);
-    void run();
 Q_SIGNALS:
     void decodeFailure(const QString &apk);
     void decodeSuccess(const QString &dir);
@@ -0,0 +1,40 @@
+#ifndef DEXREADER_H
+#define DEXREADER_H
+
+#include <QString>
+#include <QVector>
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Counts what a classes.dex holds from its header, string_ids,
+ * type_ids and class_defs, without touching code items. Works in place over
+ * the given bytes; only package names are copied out.
+ */
+class DexReader
+{
+public:
+    struct Package
+    {
+        QString name;
+        int classes;
+        int methods;
+    };
+    struct Summary
+    {
+        int classes;
+        int fieldRefs;
+        int methodRefs;
+        int methods;
+        int strings;
+        int version;
+        QVector<Package> packages;
+    };
+public:
+    static bool read(const uchar *data, const qint64 size, Summary *summary);
+};
+
+APP_NAMESPACE_END
+
+#endif // DEXREADER_H
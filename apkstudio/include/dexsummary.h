@@ -0,0 +1,29 @@
+#ifndef DEXSUMMARY_H
+#define DEXSUMMARY_H
+
+#include <QLabel>
+#include <QTreeWidget>
+#include "dialog.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Classes, methods and packages of each classes*.dex in an APK, read
+ * straight from the archive so the decode options can be picked knowingly.
+ */
+class DexSummary : public Dialog
+{
+    Q_OBJECT
+private:
+    QLabel *_totals;
+    QTreeWidget *_tree;
+private:
+    void summarise(const QString &apk);
+public:
+    explicit DexSummary(const QString &apk, QWidget *parent);
+    static void display(const QString &apk, QWidget *parent);
+};
+
+APP_NAMESPACE_END
+
+#endif // DEXSUMMARY_H
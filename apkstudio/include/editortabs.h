@@ -2,14 +2,17 @@
 #define EDITORTABS_H
 
 #include <QFileIconProvider>
+#include <QHash>
 #include <QMap>
 #include <QPointer>
+#include <QSharedPointer>
 #include <QTabWidget>
 #include "macros.h"
 
 APP_NAMESPACE_START
 
 class FindReplace;
+class ResourceTable;
 
 class EditorTabs : public QTabWidget
 {
@@ -19,30 +22,40 @@ private:
     QMap<QString, int> _files;
     QPointer<FindReplace> _finder;
     QFileIconProvider _provider;
+    QHash<QString, QPair<qint64, QSharedPointer<ResourceTable> > > _tables;
+private:
+    void requestSymbol(const bool usages);
+    ResourceTable *table(const QString &path);
 public:
     explicit EditorTabs(QWidget *parent = 0);
     ~EditorTabs();
 private Q_SLOTS:
+    void onCoderLoaded();
     void onCurrentChanged(const int index);
     void onFileClose();
     void onFileCloseAll();
     void onEditCopy();
     void onEditCut();
     void onEditFind();
+    inline void onEditFindUsages() { requestSymbol(true); }
     void onEditGoto();
+    inline void onEditGotoDefinition() { requestSymbol(false); }
     void onEditPaste();
     void onEditRedo();
     void onEditReplace();
     void onEditUndo();
     void onFileOpen(const QString &path);
+    void onFileOpenAt(const QString &path, const int line);
     void onFileSave();
     void onFileSave(const int i);
     void onFileSaveAll();
     void onTabCloseRequested(const int index);
     void onTabMoved(const int from, const int to);
+    void onTooltipRequested(const QPoint &position);
 Q_SIGNALS:
     void fileChanged(QString);
     void fileSaved(QString);
+    void symbolRequested(const QString &symbol, const bool usages);
 };
 
 APP_NAMESPACE_END
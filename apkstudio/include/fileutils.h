@@ -10,7 +10,10 @@ APP_NAMESPACE_START
 
 class FileUtils
 {
+private:
+    static bool cloneFile(const QString &from, const QString &to);
 public:
+    static bool clone(const QString &from, const QString &to);
     static QString read(const QString &path);
     static bool rimraf(const QString &dir);
     static void show(const QString &p);
@@ -4,14 +4,13 @@
 #include <QDropEvent>
 #include <QMainWindow>
 #include <QPointer>
+#include <QSet>
 #include "include/consoledock.h"
 #include "include/projectdock.h"
 #include "macros.h"
 
 APP_NAMESPACE_START
 
-class PleaseWait;
-
 class StatusBar;
 
 class Ide : public QMainWindow
@@ -20,10 +19,11 @@ class Ide : public QMainWindow
 private:
     APP_CONNECTIONS_LIST
     QString _apk;
+    int _install;
     bool _signed;
-    QPointer<PleaseWait> _pleaseWait;
     QString _project;
     bool _quit;
+    QSet<QString> _saved;
     StatusBar *_statusBar;
 protected:
     void closeEvent(QCloseEvent *event);
@@ -37,10 +37,12 @@ public:
 public Q_SLOTS:
     void onBuildFailure(const QString &project);
     void onBuildSuccess(const QString &apk);
+    void onDecodeBatchFinished(const QString &report, const int succeeded, const int total);
     void onDecodeFailure(const QString &apk);
     void onDecodeSuccess(const QString &project);
     void onFileChanged(const QString &path);
     void onFileOpen(const QString &path);
+    void onFileOpenAt(const QString &path, const int line);
     void onFileSaved(const QString &path);
     void onInit();
     void onInstallFailure(const QString &apk);
@@ -48,7 +50,10 @@ public Q_SLOTS:
     inline void onMenuBarEditCopy() { emit editCopy(); }
     inline void onMenuBarEditCut() { emit editCut(); }
     inline void onMenuBarEditFind() { emit editFind(); }
+    inline void onMenuBarEditFindInFiles() { emit editFindInFiles(); }
+    inline void onMenuBarEditFindUsages() { emit editFindUsages(); }
     inline void onMenuBarEditGoto() { emit editGoto(); }
+    inline void onMenuBarEditGotoDefinition() { emit editGotoDefinition(); }
     inline void onMenuBarEditPaste() { emit editPaste(); }
     inline void onMenuBarEditRedo() { emit editRedo(); }
     inline void onMenuBarEditReplace() { emit editReplace(); }
@@ -56,7 +61,10 @@ public Q_SLOTS:
     inline void onMenuBarEditUndo() { emit editUndo(); }
     inline void onMenuBarFileClose() { emit fileClose(); }
     inline void onMenuBarFileCloseAll() { emit fileCloseAll(); }
+    void onMenuBarFileBrowseApk();
     void onMenuBarFileOpenApk();
+    void onMenuBarFileOpenApkFolder();
+    void onMenuBarFileOpenApks();
     void onMenuBarFileOpenDir();
     void onMenuBarFileOpenFile();
     inline void onMenuBarFileQuit() { close(); }
@@ -69,22 +77,27 @@ public Q_SLOTS:
     void onMenuBarHelpFeedbackIssues();
     void onMenuBarHelpFeedbackThanks();
     void onMenuBarProjectBuild();
+    void onMenuBarProjectBuildSignInstall();
     void onMenuBarProjectInstall();
     void onMenuBarProjectReload();
     void onMenuBarProjectSignExport();
     void onToolBarProjectSign();
     void onMenuBarProjectBrowseFiles();
     void onOpenApk(const QString &apk);
+    void onOpenApks(const QStringList &apks);
     void onOpenDir(const QString &project);
-    void onRunnableStarted();
-    void onRunnableStopped();
     void onSignFailure(const QString &apk);
     void onSignSuccess(const QString &apk);
+    void onSymbolRequested(const QString &symbol, const bool usages);
 Q_SIGNALS:
+    void apkBrowse(const QString &apk);
     void editCopy();
     void editCut();
     void editFind();
+    void editFindInFiles();
+    void editFindUsages();
     void editGoto();
+    void editGotoDefinition();
     void editPaste();
     void editRedo();
     void editReplace();
@@ -92,10 +105,12 @@ Q_SIGNALS:
     void fileClose();
     void fileCloseAll();
     void fileOpen(const QString &path);
+    void fileOpenAt(const QString &path, const int line);
     void fileSave();
     void fileSaveAll();
     void projectOpen(const QString &path);
     void projectReload();
+    void symbolRequested(const QString &symbol, const bool usages);
 };
 
 APP_NAMESPACE_END
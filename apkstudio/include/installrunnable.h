@@ -11,9 +11,10 @@ class InstallRunnable : public Runnable
     Q_OBJECT
 private:
     QString _apk;
+protected:
+    bool execute();
 public:
     explicit InstallRunnable(const QString &apk, QObject *parent = 0);
-    void run();
 Q_SIGNALS:
     void installFailure(const QString &apk);
     void installSuccess(const QString &apk);
@@ -12,6 +12,7 @@ private:
     static Java *_self;
 protected:
     explicit Java(QObject *parent = 0);
+    Process::Result execJar(const QString &jar, const QStringList &args);
 public:
     inline Process::Result exec(const QString &arg) { return exec(QStringList(arg)); }
     virtual Process::Result exec(const QStringList &args);
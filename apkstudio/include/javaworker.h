@@ -0,0 +1,60 @@
+#ifndef JAVAWORKER_H
+#define JAVAWORKER_H
+
+#include <functional>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QProcess>
+#include <QStringList>
+#include <QThread>
+#include <QWaitCondition>
+#include "canceltoken.h"
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief A resident JVM that runs the main class of a jar in-process, so
+ * repeated tool runs skip JVM startup and keep their JIT-compiled code.
+ *
+ * A QProcess can only be used from the thread that created it, so every
+ * worker owns a thread that runs its process; callers hand it one request at
+ * a time and wait. There are never more workers than Java jobs may run at
+ * once, and idle ones are kept until stopAll().
+ */
+class JavaWorker : public QThread
+{
+public:
+    typedef std::function<void(const QStringList &lines, const bool error)> Sink;
+private:
+    std::function<void()> _call;
+    QWaitCondition _done;
+    int _generation;
+    int _heap;
+    QString _java;
+    QMutex _mutex;
+    QProcess *_process;
+    QAtomicInt _running;
+    bool _stopping;
+    QWaitCondition _wake;
+private:
+    explicit JavaWorker(const QString &java, const int heap, const int generation);
+    void call(const std::function<void()> &function);
+    int collect(const CancelToken &cancel, const Sink &sink);
+    int launch(const bool allow);
+    bool post(const QString &jar, const QStringList &args);
+    bool spawn();
+protected:
+    void run();
+public:
+    ~JavaWorker();
+    static JavaWorker *acquire(const QString &java, const int heap, const int limit);
+    int receive(const CancelToken &cancel, const Sink &sink);
+    static void release(JavaWorker *worker);
+    bool send(const QString &jar, const QStringList &args);
+    static void stopAll();
+};
+
+APP_NAMESPACE_END
+
+#endif // JAVAWORKER_H
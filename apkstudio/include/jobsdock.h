@@ -0,0 +1,39 @@
+#ifndef JOBSDOCK_H
+#define JOBSDOCK_H
+
+#include <QDockWidget>
+#include <QHash>
+#include <QTreeWidget>
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Every job added to the Runner with its state; queued and running
+ * ones can be cancelled from the context menu.
+ */
+class JobsDock : public QDockWidget
+{
+    Q_OBJECT
+private:
+    APP_CONNECTIONS_LIST
+    QHash<int, QTreeWidgetItem *> _items;
+    QTreeWidget *_tree;
+public:
+    enum JobsDockRole
+    {
+        RoleJob = Qt::UserRole + 1,
+        RoleState
+    };
+public:
+    explicit JobsDock(QWidget *parent = 0);
+    ~JobsDock();
+private Q_SLOTS:
+    void onContextMenuRequested(const QPoint &point);
+    void onJobAdded(const int id, const QString &title);
+    void onJobChanged(const int id, const int state);
+};
+
+APP_NAMESPACE_END
+
+#endif // JOBSDOCK_H
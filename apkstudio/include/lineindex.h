@@ -0,0 +1,28 @@
+#ifndef LINEINDEX_H
+#define LINEINDEX_H
+
+#include <QStringList>
+#include <QVector>
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Finds line breaks 16 or 32 bytes at a time with SSE2/AVX2 where the
+ * CPU has them, and one at a time everywhere else.
+ */
+class LineIndex
+{
+private:
+    static void scan(const uchar *data, const qint64 size, const bool cr, QVector<qint64> &ends);
+    static void scan(const ushort *data, const int size, const bool cr, QVector<int> &ends);
+public:
+    static QVector<qint64> build(const uchar *data, const qint64 size);
+    static QVector<int> build(const QString &text);
+    static QStringList split(const QByteArray &data);
+    static QStringList split(const QString &text);
+};
+
+APP_NAMESPACE_END
+
+#endif // LINEINDEX_H
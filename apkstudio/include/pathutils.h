@@ -8,6 +8,8 @@ APP_NAMESPACE_START
 
 class PathUtils
 {
+private:
+    static QString lookup(const QString &exe);
 public:
     static QString combine(const QString &l, const QString &r);
     static QString find(const QString &exe);
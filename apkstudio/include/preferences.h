@@ -1,6 +1,7 @@
 #ifndef PREFERENCES_H
 #define PREFERENCES_H
 
+#include <QMutex>
 #include <QPointer>
 #include <QSettings>
 #include "macros.h"
@@ -11,6 +12,7 @@ class Preferences
 {
 private:
     QString _appPath;
+    QMutex _mutex;
     static Preferences *_self;
     QSettings *_settings;
 private:
@@ -25,6 +27,8 @@ public:
     QString vendorPath();
     QByteArray docksState();
     int javaHeap();
+    bool javaWorker();
+    int parallelJobs();
     QString previousApk();
     QString previousDir();
     QStringList sessionFiles();
@@ -37,12 +41,15 @@ public:
     int tabStopWidth();
     int textEncoding();
     bool useSpacesForTabs();
+    int viewerThreshold();
     bool wasWindowMaximized();
     QSize windowSize();
     // Setters
     Preferences *setVendorPath(const QString &path);
     Preferences *setDocksState(const QByteArray &state);
     Preferences *setJavaHeap(const int mb);
+    Preferences *setJavaWorker(const bool use);
+    Preferences *setParallelJobs(const int jobs);
     Preferences *setPreviousDir(const QString &dir);
     Preferences *setSessionFiles(const QStringList &files);
     Preferences *setSessionProject(const QString &project);
@@ -54,6 +61,7 @@ public:
     Preferences *setTabStopWidth(const int width);
     Preferences *setTextEncoding(const int codec);
     Preferences *setUseSpacesForTabs(const bool use);
+    Preferences *setViewerThreshold(const int mb);
     Preferences *setWindowMaximized(const bool maximized);
     Preferences *setWindowSize(const QSize &size);
 };
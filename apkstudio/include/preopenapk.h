@@ -19,8 +19,10 @@ private:
     QCheckBox *_sources;
 private Q_SLOTS:
     void onBrowseProject();
+    void onDexSummary();
 public:
     explicit PreOpenApk(const QString &apk, QWidget *parent);
+    static void listFrameworks(QComboBox *combo);
 public Q_SLOTS:
     void accept();
 };
@@ -0,0 +1,33 @@
+#ifndef PREOPENAPKS_H
+#define PREOPENAPKS_H
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QLineEdit>
+#include <QSpinBox>
+#include "dialog.h"
+
+APP_NAMESPACE_START
+
+class PreOpenApks : public Dialog
+{
+    Q_OBJECT
+private:
+    QStringList _apks;
+    QComboBox *_framework;
+    QSpinBox *_javaHeap;
+    QLineEdit *_output;
+    QSpinBox *_parallelJobs;
+    QCheckBox *_resources;
+    QCheckBox *_sources;
+private Q_SLOTS:
+    void onBrowseOutput();
+public:
+    explicit PreOpenApks(const QStringList &apks, QWidget *parent);
+public Q_SLOTS:
+    void accept();
+};
+
+APP_NAMESPACE_END
+
+#endif // PREOPENAPKS_H
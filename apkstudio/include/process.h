@@ -1,33 +1,58 @@
 #ifndef PROCESS_H
 #define PROCESS_H
 
+#include <QMutex>
 #include <QRegularExpression>
 #include <QStringList>
+#include <QVector>
+#include <QWaitCondition>
+#include "canceltoken.h"
 #include "macros.h"
 
 APP_NAMESPACE_START
 
+/**
+ * @brief Runs a tool and streams its output as it arrives. Lines wait in a
+ * bounded queue until taken; once it is full, reading from the child stops
+ * until the consumer catches up, so a chatty tool cannot outrun the UI.
+ * The result keeps the first and the last lines of each stream.
+ */
 class Process : public QObject
 {
     Q_OBJECT
-private:
-    QString _exe;
-    QRegularExpression _lf;
-public:
-    explicit Process(const QString &exe, QObject *parent = 0);
 public:
+    struct Line
+    {
+        bool error;
+        QString text;
+    };
     struct Result
     {
         int code;
         QStringList error;
         QStringList output;
     };
+private:
+    QWaitCondition _drained;
+    QString _exe;
+    QVector<Line> _lines;
+    QMutex _mutex;
+protected:
+    inline QString exe() const { return _exe; }
+    void push(const QStringList &lines, const bool error, Result &result);
+public:
+    explicit Process(const QString &exe, QObject *parent = 0);
 public:
     inline Result exec(const QString &arg) { return exec(QStringList(arg)); }
     virtual Result exec(const QStringList &args = QStringList());
+    virtual QString path() const { return _exe; }
+    QVector<Line> take();
+    static CancelToken cancelToken();
+    static void setCancelToken(const CancelToken &token);
 Q_SIGNALS:
     void executed(Result);
     void executing(QString, QStringList);
+    void outputReady();
 };
 
 APP_NAMESPACE_END
@@ -2,22 +2,20 @@
 #define PROJECTDOCK_H
 
 #include <QDockWidget>
-#include <QFileIconProvider>
-#include <QTreeWidgetItem>
-#include <QTreeWidget>
+#include <QTreeView>
 #include "macros.h"
 
 APP_NAMESPACE_START
 
+class ProjectModel;
+
 class ProjectDock : public QDockWidget
 {
     Q_OBJECT
 private:
     APP_CONNECTIONS_LIST
-    QFileIconProvider _fip;
-    QTreeWidget *_tree;
-private:
-    void onItemRefresh(QTreeWidgetItem *item);
+    ProjectModel *_model;
+    QTreeView *_tree;
 public:
     enum ProjectDockRole
     {
@@ -0,0 +1,29 @@
+#ifndef PROJECTLISTER_H
+#define PROJECTLISTER_H
+
+#include <QObject>
+#include <QRunnable>
+#include <QStringList>
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Lists one directory of the project tree off the GUI thread.
+ */
+class ProjectLister : public QObject, public QRunnable
+{
+    Q_OBJECT
+private:
+    int _generation;
+    QString _path;
+public:
+    explicit ProjectLister(const int generation, const QString &path);
+    void run();
+Q_SIGNALS:
+    void listed(const int generation, const QString &path, const QStringList &dirs, const QStringList &files);
+};
+
+APP_NAMESPACE_END
+
+#endif // PROJECTLISTER_H
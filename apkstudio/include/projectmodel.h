@@ -0,0 +1,84 @@
+#ifndef PROJECTMODEL_H
+#define PROJECTMODEL_H
+
+#include <QAbstractItemModel>
+#include <QFileIconProvider>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QIcon>
+#include <QSet>
+#include <QSharedPointer>
+#include <QTimer>
+#include <QVector>
+#include "canceltoken.h"
+#include "projectsnapshot.h"
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Project tree that lists a directory only once it is expanded, in
+ * the background, and shares one icon between all files of a suffix. Listed
+ * directories are watched; changes are coalesced and applied as row diffs so
+ * expansion and selection survive them. A snapshot from the previous session,
+ * when there is one, fills directories at once until their listing lands.
+ */
+class ProjectModel : public QAbstractItemModel
+{
+    Q_OBJECT
+private:
+    struct Node
+    {
+        QVector<Node *> children;
+        bool dir;
+        bool listed;
+        bool listing;
+        QString name;
+        Node *parent;
+        int row;
+        ~Node() { qDeleteAll(children); }
+    };
+    QSet<QString> _changed;
+    int _generation;
+    mutable QHash<QString, QIcon> _icons;
+    QHash<QString, Node *> _pending;
+    QString _project;
+    mutable QFileIconProvider _provider;
+    Node *_root;
+    CancelToken _scan;
+    QSharedPointer<ProjectSnapshot> _snapshot;
+    QTimer _timer;
+    QFileSystemWatcher _watcher;
+private:
+    void apply(Node *node, const QStringList &dirs, const QStringList &files);
+    Node *find(const QString &path) const;
+    QIcon icon(const Node *node) const;
+    void list(Node *node);
+    Node *node(const QModelIndex &index) const;
+    QString path(const Node *node) const;
+    void populate(Node *node, const QStringList &dirs, const QStringList &files);
+    QString relative(const Node *node) const;
+    void release(Node *node);
+public:
+    explicit ProjectModel(QObject *parent = 0);
+    bool canFetchMore(const QModelIndex &parent) const;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+    void fetchMore(const QModelIndex &parent);
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const;
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const;
+    QModelIndex parent(const QModelIndex &index) const;
+    inline QString project() const { return _project; }
+    void refresh();
+    int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    void setProject(const QString &path);
+    ~ProjectModel();
+private Q_SLOTS:
+    void onDirectoryChanged(const QString &path);
+    void onListed(const int generation, const QString &path, const QStringList &dirs, const QStringList &files);
+    void onTimeout();
+};
+
+APP_NAMESPACE_END
+
+#endif // PROJECTMODEL_H
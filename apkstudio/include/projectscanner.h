@@ -0,0 +1,36 @@
+#ifndef PROJECTSCANNER_H
+#define PROJECTSCANNER_H
+
+#include <QObject>
+#include <QRunnable>
+#include <QSharedPointer>
+#include "canceltoken.h"
+#include "projectsnapshot.h"
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Walks a whole project on every core and writes a fresh snapshot of
+ * it. Workers take directories from the back of their own queue and steal
+ * from the front of the others'; a directory whose modification time matches
+ * the previous snapshot is not read again.
+ */
+class ProjectScanner : public QObject, public QRunnable
+{
+    Q_OBJECT
+private:
+    QString _file;
+    QSharedPointer<ProjectSnapshot> _previous;
+    QString _project;
+    CancelToken _token;
+public:
+    explicit ProjectScanner(const CancelToken &token, const QString &project, const QString &file, const QSharedPointer<ProjectSnapshot> &previous);
+    void run();
+Q_SIGNALS:
+    void finished(const QString &project);
+};
+
+APP_NAMESPACE_END
+
+#endif // PROJECTSCANNER_H
@@ -0,0 +1,64 @@
+#ifndef PROJECTSNAPSHOT_H
+#define PROJECTSNAPSHOT_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QStringList>
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Listing of every directory of a project as of the last scan, kept
+ * in the app folder so a reopened project fills its tree without touching the
+ * disk. The file is memory-mapped; directories are sorted by relative path.
+ */
+class ProjectSnapshot
+{
+public:
+    struct Header
+    {
+        char magic[4];
+        quint32 version;
+        quint32 dirs;
+        quint32 entries;
+        quint64 dirsOffset;
+        quint64 entriesOffset;
+        quint64 stringsOffset;
+        quint64 size;
+    };
+    struct Dir
+    {
+        qint64 modified;
+        quint32 path;
+        quint32 length;
+        quint32 first;
+        quint32 dirs;
+        quint32 files;
+        quint32 reserved;
+    };
+    struct Entry
+    {
+        quint32 name;
+        quint32 length;
+    };
+private:
+    QByteArray _buffer;
+    const uchar *_data;
+    const Dir *_dirs;
+    const Entry *_entries;
+    QFile _file;
+    const Header *_header;
+private:
+    QString string(const quint32 offset, const quint32 length) const;
+public:
+    ProjectSnapshot();
+    bool listing(const QString &relative, QStringList &dirs, QStringList &files, qint64 *modified = 0) const;
+    bool open(const QString &path);
+    static QString path(const QString &project);
+    ~ProjectSnapshot();
+};
+
+APP_NAMESPACE_END
+
+#endif // PROJECTSNAPSHOT_H
@@ -0,0 +1,57 @@
+#ifndef RESOURCETABLE_H
+#define RESOURCETABLE_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QStringList>
+#include <QVector>
+#include "stringpool.h"
+#include "zipreader.h"
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Looks resource ids up in a resources.arsc, either a file of its own
+ * or inside an APK. Opening only notes where each package starts; a package
+ * is indexed on its first lookup, and even then only the offsets of its type
+ * chunks are kept. Names, values and configurations are read from the mapped
+ * table per lookup, so memory follows what is asked rather than table size.
+ */
+class ResourceTable
+{
+private:
+    struct Package
+    {
+        quint32 id;
+        quint32 offset;
+        bool indexed;
+        QString name;
+        StringPool keys;
+        StringPool types;
+        QVector<QVector<quint32> > chunks;
+    };
+    QByteArray _buffer;
+    const uchar *_data;
+    QFile _file;
+    QVector<Package> _packages;
+    qint64 _size;
+    StringPool _strings;
+    ZipReader _zip;
+private:
+    const uchar *entry(const quint32 chunk, const quint32 index) const;
+    Package *package(const quint32 id);
+    bool parse();
+    QString text(const uchar *entry, const uchar *end);
+public:
+    ResourceTable();
+    QString name(const quint32 id);
+    bool open(const QString &path);
+    QStringList values(const quint32 id);
+    static QString config(const uchar *config, const quint32 size);
+    static QString sourceFor(const QString &path);
+};
+
+APP_NAMESPACE_END
+
+#endif // RESOURCETABLE_H
@@ -3,23 +3,47 @@
 
 #include <QRunnable>
 #include <QObject>
+#include "canceltoken.h"
 #include "macros.h"
 
 APP_NAMESPACE_START
 
+/**
+ * @brief A job for the Runner. It holds one slot of its resource while it
+ * runs, and its tools are killed when it is cancelled.
+ */
 class Runnable : public QObject, public QRunnable
 {
     Q_OBJECT
+public:
+    enum State
+    {
+        StateQueued,
+        StateRunning,
+        StateSucceeded,
+        StateFailed,
+        StateCancelled
+    };
 protected:
     APP_CONNECTIONS_LIST
+private:
+    QString _resource;
+    QString _title;
+    CancelToken _token;
+protected:
+    virtual bool execute() = 0;
 public:
-    explicit Runnable(QObject *parent = 0);
+    explicit Runnable(const QString &title, const QString &resource, QObject *parent = 0);
     ~Runnable();
 public:
-    virtual void run() = 0;
+    inline void cancel() { _token->store(1); }
+    inline bool isCancelled() const { return _token->load() != 0; }
+    inline QString resource() const { return _resource; }
+    void run();
+    inline QString title() const { return _title; }
 signals:
     void runnableStarted();
-    void runnableStopped();
+    void runnableStopped(const bool success);
 };
 
 APP_NAMESPACE_END
@@ -1,25 +1,60 @@
 #ifndef RUNNER_H
 #define RUNNER_H
 
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMap>
 #include <QThreadPool>
 #include "macros.h"
 #include "runnable.h"
 
 APP_NAMESPACE_START
 
+/**
+ * @brief Schedules jobs in the order they were added. A job starts once the
+ * job it comes after has succeeded and its resource has a free slot; if that
+ * job fails or is cancelled, everything chained after it is cancelled too.
+ */
 class Runner : public QObject
 {
     Q_OBJECT
+private:
+    struct Job
+    {
+        int after;
+        qint64 elapsed;
+        Runnable *runnable;
+        Runnable::State state;
+        QElapsedTimer timer;
+    };
 protected:
     APP_CONNECTIONS_LIST
+    QHash<QString, int> _busy;
+    QHash<Runnable *, int> _ids;
+    QMap<int, Job> _jobs;
+    int _last;
     QThreadPool *_pool;
+    QList<int> _queue;
     static Runner *_self;
+private:
+    int limit(const QString &resource) const;
+    void schedule();
+    void setState(const int id, const Runnable::State state);
+private Q_SLOTS:
+    void onRunnableStopped(const bool success);
 public:
     explicit Runner(QObject *parent = 0);
     ~Runner();
 public:
-    void add(Runnable *runnable);
+    int add(Runnable *runnable, const int after = 0);
+    void cancel(const int id);
+    qint64 elapsed(const int id) const;
     static Runner *get();
+    Runnable::State state(const int id) const;
+Q_SIGNALS:
+    void jobAdded(const int id, const QString &title);
+    void jobChanged(const int id, const int state);
 };
 
 APP_NAMESPACE_END
@@ -0,0 +1,74 @@
+#ifndef SEARCHDOCK_H
+#define SEARCHDOCK_H
+
+#include <QCheckBox>
+#include <QDockWidget>
+#include <QLabel>
+#include <QLineEdit>
+#include <QSharedPointer>
+#include <QTimer>
+#include <QTreeWidget>
+#include "searchworker.h"
+#include "smaliindex.h"
+#include "trigramindex.h"
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+class SearchDock : public QDockWidget
+{
+    Q_OBJECT
+private:
+    APP_CONNECTIONS_LIST
+    QCheckBox *_caseSensitive;
+    int _files;
+    int _generation;
+    QSharedPointer<TrigramIndex> _index;
+    bool _indexing;
+    CancelToken _indexToken;
+    int _matches;
+    QString _project;
+    QLineEdit *_query;
+    QTimer _reindex;
+    QSharedPointer<SmaliIndex> _symbols;
+    bool _symbolsIndexing;
+    int _running;
+    SearchQuery _search;
+    QLabel *_status;
+    QTimer _timer;
+    CancelToken _token;
+    QTreeWidget *_tree;
+    QCheckBox *_useRegex;
+private:
+    void cancel();
+    void showLocations(const QString &status, const QVector<SmaliIndex::Location> &locations);
+    void updateStatus();
+public:
+    enum SearchDockRole
+    {
+        RolePath = Qt::UserRole + 1,
+        RoleLine
+    };
+public:
+    explicit SearchDock(QWidget *parent = 0);
+    ~SearchDock();
+private Q_SLOTS:
+    void onFilesFound(const int generation, const QStringList &files);
+    void onFindInFiles();
+    void onIndexed(const QString &project);
+    void onIndexStale();
+    void onItemActivated(QTreeWidgetItem *item, const int column);
+    void onMatchesFound(const int generation, const QString &path, const SearchMatchList &matches);
+    void onProjectOpen(const QString &path);
+    void onReindex();
+    void onSearch();
+    void onSymbolRequested(const QString &symbol, const bool usages);
+    void onSymbolsIndexed(const QString &project);
+    void onWorkerFinished(const int generation);
+Q_SIGNALS:
+    void fileOpenAt(const QString &path, const int line);
+};
+
+APP_NAMESPACE_END
+
+#endif // SEARCHDOCK_H
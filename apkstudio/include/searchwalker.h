@@ -0,0 +1,39 @@
+#ifndef SEARCHWALKER_H
+#define SEARCHWALKER_H
+
+#include <QObject>
+#include <QRunnable>
+#include <QSharedPointer>
+#include <QStringList>
+#include "searchworker.h"
+#include "trigramindex.h"
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Lists the searchable files under a project in batches, so scanning
+ * can start before the walk is over. Indexed files that are up to date and
+ * lack a required trigram are left out.
+ */
+class SearchWalker : public QObject, public QRunnable
+{
+    Q_OBJECT
+private:
+    int _generation;
+    QSharedPointer<TrigramIndex> _index;
+    QString _root;
+    CancelToken _token;
+    QVector<quint32> _trigrams;
+public:
+    explicit SearchWalker(const CancelToken &token, const int generation, const QString &root, const QSharedPointer<TrigramIndex> &index = QSharedPointer<TrigramIndex>(), const QVector<quint32> &trigrams = QVector<quint32>());
+    void run();
+Q_SIGNALS:
+    void filesFound(const int generation, const QStringList &files);
+    void finished(const int generation);
+    void indexStale();
+};
+
+APP_NAMESPACE_END
+
+#endif // SEARCHWALKER_H
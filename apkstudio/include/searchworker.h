@@ -0,0 +1,54 @@
+#ifndef SEARCHWORKER_H
+#define SEARCHWORKER_H
+
+#include <QAtomicInt>
+#include <QMetaType>
+#include <QObject>
+#include <QRunnable>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVector>
+#include "canceltoken.h"
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+struct SearchMatch
+{
+    int line;
+    int column;
+    int length;
+    QString preview;
+};
+
+typedef QVector<SearchMatch> SearchMatchList;
+
+struct SearchQuery
+{
+    bool caseSensitive;
+    int encoding;
+    bool regex;
+    QString text;
+};
+
+class SearchWorker : public QObject, public QRunnable
+{
+    Q_OBJECT
+private:
+    QStringList _files;
+    int _generation;
+    SearchQuery _query;
+    CancelToken _token;
+public:
+    explicit SearchWorker(const CancelToken &token, const int generation, const SearchQuery &query, const QStringList &files);
+    void run();
+Q_SIGNALS:
+    void finished(const int generation);
+    void matchesFound(const int generation, const QString &path, const SearchMatchList &matches);
+};
+
+APP_NAMESPACE_END
+
+Q_DECLARE_METATYPE(APP_NAMESPACE::SearchMatchList)
+
+#endif // SEARCHWORKER_H
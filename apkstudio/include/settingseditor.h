@@ -15,10 +15,13 @@ class SettingsEditor : public Dialog
 private:
     QLineEdit *_vendorPath;
     QSpinBox *_javaHeap;
+    QCheckBox *_javaWorker;
+    QSpinBox *_parallelJobs;
     QCheckBox *_showWhitespaces;
     QSpinBox *_tabStopWidth;
     QComboBox *_textEncoding;
     QCheckBox *_useSpacesForTabs;
+    QSpinBox *_viewerThreshold;
 private Q_SLOTS:
     void onBrowseVendor();
     void onSaveClicked();
@@ -15,9 +15,10 @@ private:
     QString _keystore;
     QString _keystorePass;
     QString _src;
+protected:
+    bool execute();
 public:
     explicit SignRunnable(const QString &src, const QString &keyStore, const QString &keyStorePass, const QString &key, const QString &keyPass, QObject *parent = 0);
-    void run();
 Q_SIGNALS:
     void signFailure(const QString &apk);
     void signSuccess(const QString &apk);
@@ -0,0 +1,59 @@
+#ifndef SMALIINDEX_H
+#define SMALIINDEX_H
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Symbol table of a decoded project's smali: class, .field and .method
+ * declarations plus the call sites and field accesses that refer to them.
+ *
+ * Symbols and paths are interned once into a single string arena and entries
+ * refer to them by id, so the table stays a handful of flat vectors however
+ * many classes there are. Members are keyed as "Lpkg/Class;->name(args)ret"
+ * or "Lpkg/Class;->name:Type", the way smali itself references them.
+ */
+class SmaliIndex
+{
+public:
+    struct Location
+    {
+        QString path;
+        int line;
+    };
+private:
+    struct Entry
+    {
+        quint32 symbol;
+        quint32 file;
+        quint32 line;
+    };
+    QVector<Entry> _definitions;
+    QVector<quint32> _offsets;
+    QVector<quint32> _slots;
+    QVector<quint32> _sorted;
+    QByteArray _strings;
+    QVector<Entry> _usages;
+private:
+    int find(const char *data, const int size) const;
+    quint32 intern(const char *data, const int size);
+    QVector<Location> locations(const QVector<Entry> &entries, const quint32 symbol, const int limit) const;
+    QByteArray string(const quint32 id) const;
+public:
+    SmaliIndex();
+    QVector<Location> definitions(const QString &symbol) const;
+    void finish();
+    inline bool isEmpty() const { return _definitions.isEmpty(); }
+    void merge(const SmaliIndex &other);
+    void parse(const QString &path);
+    QVector<Location> usages(const QString &symbol, const int limit) const;
+    static QString symbolAt(const QString &line, const int column, const QString &owner);
+};
+
+APP_NAMESPACE_END
+
+#endif // SMALIINDEX_H
@@ -0,0 +1,34 @@
+#ifndef SMALIINDEXER_H
+#define SMALIINDEXER_H
+
+#include <QObject>
+#include <QRunnable>
+#include <QSharedPointer>
+#include "canceltoken.h"
+#include "smaliindex.h"
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Parses every smali file of a project on all cores, each thread into
+ * its own table, and merges the tables once they are done.
+ */
+class SmaliIndexer : public QObject, public QRunnable
+{
+    Q_OBJECT
+private:
+    QSharedPointer<SmaliIndex> _index;
+    QString _project;
+    CancelToken _token;
+public:
+    explicit SmaliIndexer(const CancelToken &token, const QString &project);
+    inline QSharedPointer<SmaliIndex> index() const { return _index; }
+    void run();
+Q_SIGNALS:
+    void finished(const QString &project);
+};
+
+APP_NAMESPACE_END
+
+#endif // SMALIINDEXER_H
@@ -1,7 +1,10 @@
 #ifndef STATUSBAR_H
 #define STATUSBAR_H
 
+#include <functional>
+#include <QHash>
 #include <QLabel>
+#include <QProgressBar>
 #include <QStatusBar>
 #include "macros.h"
 
@@ -11,10 +14,31 @@ class StatusBar : public QStatusBar
 {
     Q_OBJECT
 private:
+    enum Tool
+    {
+        ToolAdb,
+        ToolApkTool,
+        ToolJava,
+        ToolUberApkSigner,
+        ToolCount
+    };
     APP_CONNECTIONS_LIST
+    QHash<int, int> _active;
+    int _finished;
+    QLabel *_jobs;
     QLabel *_message;
+    QString _paths[ToolCount];
+    QProgressBar *_progress;
+    QLabel *_versions[ToolCount];
+private:
+    void probe(const int tool, const std::function<QString()> &probe);
+    void showVersion(const int tool, const QString &version);
+    void updateJobs();
 private Q_SLOTS:
+    void onJobAdded(const int id);
+    void onJobChanged(const int id, const int state);
     void onMessageChanged(const QString &text);
+    void onProbed(const int tool, const QString &version);
 public:
     explicit StatusBar(QWidget *parent);
     ~StatusBar();
@@ -0,0 +1,30 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <QString>
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief ResStringPool chunk as found in binary XML and resources.arsc, read
+ * in place; a string is only decoded when asked for.
+ */
+class StringPool
+{
+private:
+    int _count;
+    const uchar *_offsets;
+    qint64 _size;
+    const uchar *_strings;
+    bool _utf8;
+public:
+    StringPool();
+    QString at(const quint32 i) const;
+    inline int count() const { return _count; }
+    bool read(const uchar *chunk, const quint32 length);
+};
+
+APP_NAMESPACE_END
+
+#endif // STRINGPOOL_H
@@ -0,0 +1,58 @@
+#ifndef TEXTVIEWER_H
+#define TEXTVIEWER_H
+
+#include <QAbstractScrollArea>
+#include <QFile>
+#include <QHash>
+#include <QTextCodec>
+#include <QTextOption>
+#include <QVector>
+#include "codertokenizer.h"
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Read-only view over a memory-mapped file, for files too big for a
+ * Coder. Only the visible lines are ever decoded, laid out and highlighted.
+ */
+class TextViewer : public QAbstractScrollArea
+{
+    Q_OBJECT
+private:
+    QVector<int> _checkpoints;
+    QTextCodec *_codec;
+    int _current;
+    const uchar *_data;
+    QFile _file;
+    bool _guessed;
+    QVector<qint64> _lines;
+    QTextOption _option;
+    QHash<int, int> _states;
+    const CoderTokenizer *_tokenizer;
+    int _width;
+private:
+    int gutterWidth() const;
+    QString line(const int row) const;
+    int stateAt(const int row, bool &guessed);
+    void updateScrollBars();
+private Q_SLOTS:
+    void onCheckpoint();
+protected:
+    void keyPressEvent(QKeyEvent *event);
+    void mousePressEvent(QMouseEvent *event);
+    void paintEvent(QPaintEvent *event);
+    void resizeEvent(QResizeEvent *event);
+public:
+    explicit TextViewer(QWidget *parent = 0);
+    void copy();
+    inline int currentRow() const { return _current; }
+    bool open(const QString &path, const QString &definition);
+    inline int rowCount() const { return _lines.size(); }
+    void setCurrentRow(const int row);
+    ~TextViewer();
+};
+
+APP_NAMESPACE_END
+
+#endif // TEXTVIEWER_H
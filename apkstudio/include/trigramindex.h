@@ -0,0 +1,76 @@
+#ifndef TRIGRAMINDEX_H
+#define TRIGRAMINDEX_H
+
+#include <QBitArray>
+#include <QFile>
+#include <QHash>
+#include <QVector>
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Read side of the on-disk trigram index kept next to apktool.yml. The
+ * file is memory-mapped as is; only the header is checked on open, entries are
+ * checked against the filesystem as searches walk the project.
+ *
+ * Layout: header, file table, sorted trigram table, delta-varint postings and
+ * UTF-8 relative paths. Trigrams are ASCII-only and lower-cased, so a lookup
+ * yields candidates for both case-sensitive and insensitive queries.
+ */
+class TrigramIndex
+{
+public:
+    struct Header
+    {
+        char magic[4];
+        quint32 version;
+        quint32 files;
+        quint32 trigrams;
+        quint64 filesOffset;
+        quint64 trigramsOffset;
+        quint64 postingsOffset;
+        quint64 stringsOffset;
+        quint64 size;
+    };
+    struct File
+    {
+        qint64 modified;
+        qint64 size;
+        quint32 path;
+        quint32 length;
+    };
+    struct Trigram
+    {
+        quint32 trigram;
+        quint32 count;
+        quint64 postings;
+    };
+private:
+    const uchar *_data;
+    QFile _file;
+    const File *_files;
+    const Header *_header;
+    QHash<QString, int> _paths;
+    const Trigram *_trigrams;
+private:
+    const Trigram *find(const quint32 trigram) const;
+public:
+    TrigramIndex();
+    inline int fileCount() const { return _header ? int(_header->files) : 0; }
+    inline const File &file(const int id) const { return _files[id]; }
+    QString filePath(const int id) const;
+    inline int find(const QString &path) const { return _paths.value(path, -1); }
+    QBitArray match(const QVector<quint32> &trigrams) const;
+    bool open(const QString &project);
+    QVector<quint32> postings(const int index) const;
+    inline int trigramCount() const { return _header ? int(_header->trigrams) : 0; }
+    inline quint32 trigram(const int index) const { return _trigrams[index].trigram; }
+    static QString path(const QString &project);
+    static QVector<quint32> required(const QString &text, const bool regex);
+    ~TrigramIndex();
+};
+
+APP_NAMESPACE_END
+
+#endif // TRIGRAMINDEX_H
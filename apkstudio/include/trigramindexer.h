@@ -0,0 +1,47 @@
+#ifndef TRIGRAMINDEXER_H
+#define TRIGRAMINDEXER_H
+
+#include <QBitArray>
+#include <QByteArray>
+#include <QHash>
+#include <QObject>
+#include <QRunnable>
+#include "canceltoken.h"
+#include "trigramindex.h"
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Brings the trigram index of a project up to date. Files whose
+ * modification time and size are unchanged keep their old postings, only the
+ * rest are read again.
+ */
+class TrigramIndexer : public QObject, public QRunnable
+{
+    Q_OBJECT
+private:
+    struct Postings
+    {
+        QByteArray data;
+        quint32 count;
+        quint32 last;
+    };
+    QHash<quint32, Postings> _postings;
+    QString _project;
+    QBitArray _seen;
+    CancelToken _token;
+private:
+    void add(const quint32 trigram, const quint32 id);
+    void scan(const QString &path, const quint32 id);
+    bool write(const QVector<TrigramIndex::File> &files, const QByteArray &strings);
+public:
+    explicit TrigramIndexer(const CancelToken &token, const QString &project);
+    void run();
+Q_SIGNALS:
+    void finished(const QString &project);
+};
+
+APP_NAMESPACE_END
+
+#endif // TRIGRAMINDEXER_H
@@ -23,6 +23,7 @@ public:
     Result exec(const QStringList &args = QStringList());
     static UberApkSigner *get();
     QString getVersion();
+    inline QString path() const { return _jar; }
 };
 
 APP_NAMESPACE_END
@@ -0,0 +1,30 @@
+#ifndef VERSIONPROBE_H
+#define VERSIONPROBE_H
+
+#include <functional>
+#include <QObject>
+#include <QRunnable>
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Asks one tool for its version off the GUI thread; each probe starts
+ * a process, some of them a JVM, so they run side by side.
+ */
+class VersionProbe : public QObject, public QRunnable
+{
+    Q_OBJECT
+private:
+    std::function<QString()> _probe;
+    int _tool;
+public:
+    explicit VersionProbe(const int tool, const std::function<QString()> &probe);
+    void run();
+Q_SIGNALS:
+    void probed(const int tool, const QString &version);
+};
+
+APP_NAMESPACE_END
+
+#endif // VERSIONPROBE_H
@@ -0,0 +1,51 @@
+#ifndef ZIPREADER_H
+#define ZIPREADER_H
+
+#include <QFile>
+#include <QIODevice>
+#include <QString>
+#include <QVector>
+#include "macros.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Lists a ZIP (APK, JAR) from its central directory without reading
+ * the entries themselves. The archive is memory-mapped; an entry is inflated
+ * only when asked for, a chunk at a time. ZIP64 archives are understood,
+ * encrypted and spanned ones are not.
+ */
+class ZipReader
+{
+public:
+    struct Entry
+    {
+        QString name;
+        quint64 compressed;
+        quint64 size;
+        quint64 offset;
+        quint32 crc;
+        quint16 method;
+    };
+private:
+    const uchar *_data;
+    QVector<Entry> _entries;
+    QFile _file;
+    quint64 _size;
+private:
+    bool parse();
+    const uchar *payload(const Entry &entry) const;
+public:
+    ZipReader();
+    const uchar *data(const int i) const;
+    inline const Entry &entry(const int i) const { return _entries.at(i); }
+    inline int entryCount() const { return _entries.size(); }
+    bool extract(const int i, QIODevice *out) const;
+    int find(const QString &name) const;
+    bool open(const QString &path);
+    QByteArray read(const int i) const;
+};
+
+APP_NAMESPACE_END
+
+#endif // ZIPREADER_H
@@ -1,6 +1,21 @@
 <?xml version="1.0" encoding="utf-8"?>
 <!DOCTYPE TS>
 <TS version="2.1" language="en_IN" sourcelanguage="en_IN">
+<context>
+    <name>archive</name>
+    <message>
+        <source>decode</source>
+        <translation>Decode APK</translation>
+    </message>
+    <message>
+        <source>dex_summary</source>
+        <translation>DEX Summary</translation>
+    </message>
+    <message>
+        <source>open</source>
+        <translation>Open</translation>
+    </message>
+</context>
 <context>
     <name>buttons</name>
     <message>
@@ -11,10 +26,18 @@
         <source>cancel</source>
         <translation>Cancel</translation>
     </message>
+    <message>
+        <source>close</source>
+        <translation>Close</translation>
+    </message>
     <message>
         <source>decode</source>
         <translation>Decode</translation>
     </message>
+    <message>
+        <source>dex_summary</source>
+        <translation>DEX Summary</translation>
+    </message>
     <message>
         <source>find</source>
         <translation>Find</translation>
@@ -47,16 +70,67 @@
         <translation>Process exited with code %1</translation>
     </message>
 </context>
+<context>
+    <name>dex</name>
+    <message>
+        <source>classes</source>
+        <translation>Classes</translation>
+    </message>
+    <message>
+        <source>default_package</source>
+        <translation>(default package)</translation>
+    </message>
+    <message>
+        <source>details</source>
+        <translation>%1 strings, %2 field references</translation>
+    </message>
+    <message>
+        <source>file</source>
+        <translation>%1 (version %2)</translation>
+    </message>
+    <message>
+        <source>method_refs</source>
+        <translation>Method References</translation>
+    </message>
+    <message>
+        <source>methods</source>
+        <translation>Methods</translation>
+    </message>
+    <message>
+        <source>name</source>
+        <translation>Name</translation>
+    </message>
+    <message>
+        <source>references</source>
+        <translation>%1 (%2% of the limit)</translation>
+    </message>
+    <message>
+        <source>totals</source>
+        <translation>%1 DEX files, %2 classes, %3 methods; read in %4 ms</translation>
+    </message>
+</context>
 <context>
     <name>docks</name>
+    <message>
+        <source>apk</source>
+        <translation>APK</translation>
+    </message>
     <message>
         <source>console</source>
         <translation>Console</translation>
     </message>
+    <message>
+        <source>jobs</source>
+        <translation>Jobs</translation>
+    </message>
     <message>
         <source>project</source>
         <translation>Project</translation>
     </message>
+    <message>
+        <source>search</source>
+        <translation>Search</translation>
+    </message>
 </context>
 <context>
     <name>filters</name>
@@ -103,6 +177,10 @@
         <source>decode_resources</source>
         <translation>Decode Resources</translation>
     </message>
+    <message>
+        <source>output_path</source>
+        <translation>Output Path</translation>
+    </message>
     <message>
         <source>project_path</source>
         <translation>Project Path</translation>
@@ -159,6 +237,14 @@
         <source>java_heap</source>
         <translation>Maximum Java Heap (in MBs)</translation>
     </message>
+    <message>
+        <source>java_worker</source>
+        <translation>Keep Java Running Between Tools</translation>
+    </message>
+    <message>
+        <source>parallel_jobs</source>
+        <translation>Parallel Java Jobs</translation>
+    </message>
     <message>
         <source>show_whitespaces</source>
         <translation>Show Whitespaces</translation>
@@ -167,6 +253,10 @@
         <source>use_spaces_for_tabs</source>
         <translation>Use Spaces For Tabs</translation>
     </message>
+    <message>
+        <source>viewer_threshold</source>
+        <translation>Open Read-Only Above (in MBs)</translation>
+    </message>
     <message>
         <source>tab_stop_width</source>
         <translation>Tab Stop Width</translation>
@@ -176,12 +266,67 @@
         <translation>Text Encoding</translation>
     </message>
 </context>
+<context>
+    <name>jobs</name>
+    <message>
+        <source>build</source>
+        <translation>Build %1</translation>
+    </message>
+    <message>
+        <source>cancel</source>
+        <translation>Cancel</translation>
+    </message>
+    <message>
+        <source>cancelled</source>
+        <translation>Cancelled</translation>
+    </message>
+    <message>
+        <source>clear_finished</source>
+        <translation>Clear Finished</translation>
+    </message>
+    <message>
+        <source>decode</source>
+        <translation>Decode %1</translation>
+    </message>
+    <message>
+        <source>failed</source>
+        <translation>Failed</translation>
+    </message>
+    <message>
+        <source>elapsed</source>
+        <translation>%1 (%2 s)</translation>
+    </message>
+    <message>
+        <source>install</source>
+        <translation>Install %1</translation>
+    </message>
+    <message>
+        <source>queued</source>
+        <translation>Queued</translation>
+    </message>
+    <message>
+        <source>running</source>
+        <translation>Running</translation>
+    </message>
+    <message>
+        <source>sign</source>
+        <translation>Sign %1</translation>
+    </message>
+    <message>
+        <source>succeeded</source>
+        <translation>Succeeded</translation>
+    </message>
+</context>
 <context>
     <name>menubar</name>
     <message>
         <source>build</source>
         <translation>Build</translation>
     </message>
+    <message>
+        <source>build_sign_install</source>
+        <translation>Build, Sign &amp;&amp; Install</translation>
+    </message>
     <message>
         <source>edit</source>
         <translation>Edit</translation>
@@ -198,10 +343,22 @@
         <source>find</source>
         <translation>Find</translation>
     </message>
+    <message>
+        <source>find_in_files</source>
+        <translation>Find in Files</translation>
+    </message>
+    <message>
+        <source>find_usages</source>
+        <translation>Find Usages</translation>
+    </message>
     <message>
         <source>goto</source>
         <translation>Goto</translation>
     </message>
+    <message>
+        <source>goto_definition</source>
+        <translation>Goto Definition</translation>
+    </message>
     <message>
         <source>paste</source>
         <translation>Paste</translation>
@@ -234,6 +391,18 @@
         <source>apk</source>
         <translation>APK</translation>
     </message>
+    <message>
+        <source>apk_contents</source>
+        <translation>APK Contents (Without Decoding)</translation>
+    </message>
+    <message>
+        <source>apk_folder</source>
+        <translation>Folder of APKs</translation>
+    </message>
+    <message>
+        <source>apks</source>
+        <translation>Multiple APKs</translation>
+    </message>
     <message>
         <source>directory</source>
         <translation>Directory</translation>
@@ -325,6 +494,22 @@
         <source>download_vendor</source>
         <translation><![CDATA[You need to download some 3rd-party applications/files and place them in proper directory for APK Studio to work. Please follow the <a href="https://github.com/vaibhavpandeyvpz/apkstudio#requirements">instructions here</a>]]></translation>
     </message>
+    <message>
+        <source>decode_batch_finished</source>
+        <translation>Batch decode finished, %1 succeeded. Report saved to %2</translation>
+    </message>
+    <message>
+        <source>extract_failure</source>
+        <translation>Could not extract %1, the archive may be damaged.</translation>
+    </message>
+    <message>
+        <source>invalid_apk</source>
+        <translation>%1 could not be read as an APK or ZIP archive.</translation>
+    </message>
+    <message>
+        <source>no_dex</source>
+        <translation>No readable classes*.dex was found in this APK.</translation>
+    </message>
     <message>
         <source>decode_failure</source>
         <translation>Failed to decode %1. Please check output.</translation>
@@ -369,6 +554,10 @@
         <source>no_apk</source>
         <translation>No built APK is recorded. Please click Project &gt; Build to build.</translation>
     </message>
+    <message>
+        <source>no_apk_in_folder</source>
+        <translation>No APK files were found in the chosen folder.</translation>
+    </message>
     <message>
         <source>no_project</source>
         <translation>There is no project open at this time. Choose File &gt; Open &gt; APK to create new project.</translation>
@@ -377,6 +566,26 @@
         <source>not_signed</source>
         <translation>APK is not Signed. Please Sign the APK first!.</translation>
     </message>
+    <message>
+        <source>search_results</source>
+        <translation>%1 matches in %2 files</translation>
+    </message>
+    <message>
+        <source>search_running</source>
+        <translation>Searching... %1</translation>
+    </message>
+    <message>
+        <source>symbol_definitions</source>
+        <translation>%1 definitions of %2</translation>
+    </message>
+    <message>
+        <source>symbol_usages</source>
+        <translation>%1 usages of %2</translation>
+    </message>
+    <message>
+        <source>symbols_indexing</source>
+        <translation>Symbols are still being indexed, try again in a moment.</translation>
+    </message>
 </context>
 <context>
     <name>statusbar</name>
@@ -400,6 +609,10 @@
         <source>ready</source>
         <translation>Ready!</translation>
     </message>
+    <message>
+        <source>jobs</source>
+        <translation>Jobs: %1 running, %2 queued</translation>
+    </message>
 </context>
 <context>
     <name>titles</name>
@@ -411,6 +624,18 @@
         <source>decode_apk</source>
         <translation>Decode %1</translation>
     </message>
+    <message>
+        <source>dex_summary</source>
+        <translation>DEX Summary of %1</translation>
+    </message>
+    <message>
+        <source>invalid_apk</source>
+        <translation>Invalid APK</translation>
+    </message>
+    <message>
+        <source>decode_apks</source>
+        <translation>Decode %1 APKs</translation>
+    </message>
     <message>
         <source>about</source>
         <translation>About APK Studio</translation>
@@ -423,6 +648,14 @@
         <source>choose_apk</source>
         <translation>Choose APK File</translation>
     </message>
+    <message>
+        <source>choose_apk_folder</source>
+        <translation>Choose Folder of APKs</translation>
+    </message>
+    <message>
+        <source>choose_apks</source>
+        <translation>Choose APK Files</translation>
+    </message>
     <message>
         <source>choose_keystore</source>
         <translation>Choose Existing Keystore</translation>
@@ -439,6 +672,10 @@
         <source>choose_exiting_project</source>
         <translation>Choose Existing Project (apktool.yml)</translation>
     </message>
+    <message>
+        <source>choose_output_directory</source>
+        <translation>Choose Output Directory</translation>
+    </message>
     <message>
         <source>choose_vendor_path</source>
         <translation>Choose Vendor Binaries Path</translation>
@@ -463,10 +700,6 @@
         <source>ide_alt</source>
         <translation>%1 - APK Studio</translation>
     </message>
-    <message>
-        <source>please_wait</source>
-        <translation>Please wait...</translation>
-    </message>
     <message>
         <source>settings</source>
         <translation>Edit Settings</translation>
@@ -483,6 +716,10 @@
         <source>no_apk</source>
         <translation>No Built APK</translation>
     </message>
+    <message>
+        <source>no_apks</source>
+        <translation>No APKs Found</translation>
+    </message>
     <message>
         <source>no_project</source>
         <translation>No Open Project</translation>
@@ -0,0 +1,192 @@
+import java.io.BufferedReader;
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.io.FileDescriptor;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.io.OutputStream;
+import java.io.PrintStream;
+import java.io.UnsupportedEncodingException;
+import java.lang.reflect.InvocationTargetException;
+import java.lang.reflect.Method;
+import java.net.URL;
+import java.net.URLClassLoader;
+import java.net.URLDecoder;
+import java.nio.charset.StandardCharsets;
+import java.security.Permission;
+import java.util.Arrays;
+import java.util.HashMap;
+import java.util.Map;
+import java.util.jar.JarFile;
+
+/**
+ * Resident JVM for APK Studio, so tools like apktool run without paying for
+ * JVM startup and JIT warm-up on every call.
+ *
+ * Requests arrive on stdin, one per line: the jar followed by its arguments,
+ * tab separated and percent-encoded. The main class of the jar is run in this
+ * JVM, and its output comes back on stdout as "O <line>" and "E <line>",
+ * followed by "X <code>" once it returns. Requests run one at a time.
+ */
+public class ApkStudioWorker {
+
+    private static final PrintStream REPLY = new PrintStream(new FileOutputStream(FileDescriptor.out), true);
+
+    private static final Map<String, Method> MAINS = new HashMap<>();
+
+    private static volatile boolean running;
+
+    private static class ExitTrap extends SecurityException {
+        final int status;
+
+        ExitTrap(int status) {
+            this.status = status;
+        }
+    }
+
+    private static class LineStream extends OutputStream {
+        private final char kind;
+        private final ByteArrayOutputStream line = new ByteArrayOutputStream();
+
+        LineStream(char kind) {
+            this.kind = kind;
+        }
+
+        @Override
+        public synchronized void write(int b) {
+            if (b == '\n') {
+                send();
+            } else if (b != '\r') {
+                line.write(b);
+            }
+        }
+
+        synchronized void finish() {
+            if (line.size() > 0) {
+                send();
+            }
+        }
+
+        private void send() {
+            reply(kind + " " + new String(line.toByteArray(), StandardCharsets.UTF_8));
+            line.reset();
+        }
+    }
+
+    public static void main(String[] args) throws IOException {
+        BufferedReader in = new BufferedReader(new InputStreamReader(System.in, StandardCharsets.UTF_8));
+        LineStream out = new LineStream('O');
+        LineStream err = new LineStream('E');
+        System.setIn(new ByteArrayInputStream(new byte[0]));
+        System.setOut(new PrintStream(out, true, "UTF-8"));
+        System.setErr(new PrintStream(err, true, "UTF-8"));
+        reply("READY " + (trapExit() ? 1 : 0));
+        String request;
+        while ((request = in.readLine()) != null) {
+            if (request.isEmpty()) {
+                continue;
+            }
+            int code = run(decode(request.split("\t", -1)));
+            System.out.flush();
+            System.err.flush();
+            out.finish();
+            err.finish();
+            reply("X " + code);
+        }
+    }
+
+    private static String[] decode(String[] fields) throws UnsupportedEncodingException {
+        String[] decoded = new String[fields.length];
+        for (int i = 0; i < fields.length; i++) {
+            decoded[i] = URLDecoder.decode(fields[i], "UTF-8");
+        }
+        return decoded;
+    }
+
+    /**
+     * Main method of the jar, loaded once and kept so its classes stay warm.
+     * A jar that changed on disk gets a fresh class loader.
+     */
+    private static Method mainOf(String jar) throws Exception {
+        File file = new File(jar);
+        String key = file.getAbsolutePath() + ":" + file.lastModified();
+        Method main = MAINS.get(key);
+        if (main == null) {
+            String name;
+            try (JarFile archive = new JarFile(file)) {
+                name = archive.getManifest().getMainAttributes().getValue("Main-Class");
+            }
+            ClassLoader loader = new URLClassLoader(new URL[]{file.toURI().toURL()}, ClassLoader.getPlatformClassLoader());
+            main = Class.forName(name.trim(), true, loader).getMethod("main", String[].class);
+            MAINS.put(key, main);
+        }
+        return main;
+    }
+
+    private static void reply(String line) {
+        synchronized (REPLY) {
+            REPLY.print(line);
+            REPLY.print('\n');
+            REPLY.flush();
+        }
+    }
+
+    private static int run(String[] fields) {
+        Thread thread = Thread.currentThread();
+        ClassLoader previous = thread.getContextClassLoader();
+        try {
+            Method main = mainOf(fields[0]);
+            thread.setContextClassLoader(main.getDeclaringClass().getClassLoader());
+            running = true;
+            main.invoke(null, (Object) Arrays.copyOfRange(fields, 1, fields.length));
+            return 0;
+        } catch (InvocationTargetException e) {
+            if (e.getCause() instanceof ExitTrap) {
+                return ((ExitTrap) e.getCause()).status;
+            }
+            e.getCause().printStackTrace();
+            return 1;
+        } catch (ExitTrap e) {
+            return e.status;
+        } catch (Throwable t) {
+            t.printStackTrace();
+            return 1;
+        } finally {
+            running = false;
+            thread.setContextClassLoader(previous);
+        }
+    }
+
+    /**
+     * Tools end with System.exit(), which would take this JVM down with them;
+     * it is turned into an exception while a request runs. Newer JVMs refuse
+     * to install the manager unless allowed on the command line, and 24 on
+     * never do; the worker then reports it and is not used.
+     */
+    @SuppressWarnings("removal")
+    private static boolean trapExit() {
+        try {
+            System.setSecurityManager(new SecurityManager() {
+                @Override
+                public void checkExit(int status) {
+                    if (running) {
+                        throw new ExitTrap(status);
+                    }
+                }
+
+                @Override
+                public void checkPermission(Permission permission) {
+                }
+
+                @Override
+                public void checkPermission(Permission permission, Object context) {
+                }
+            });
+            return true;
+        } catch (Throwable t) {
+            return false;
+        }
+    }
+}
@@ -0,0 +1,261 @@
+#include <algorithm>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QHeaderView>
+#include <QMenu>
+#include <QMessageBox>
+#include <QSaveFile>
+#include "include/apkdock.h"
+#include "include/axmldecoder.h"
+#include "include/constants.h"
+#include "include/dexsummary.h"
+#include "include/pathutils.h"
+#include "include/qrc.h"
+
+APP_NAMESPACE_START
+
+static QString sizeText(const quint64 s)
+{
+    if (s < 1024)
+    {
+        return QString("%1 B").arg(s);
+    }
+    if (s < (1024 * 1024))
+    {
+        return QString("%1 KB").arg(double(s) / 1024, 0, 'f', 1);
+    }
+    return QString("%1 MB").arg(double(s) / (1024 * 1024), 0, 'f', 1);
+}
+
+ApkDock::ApkDock(QWidget *p)
+    : QDockWidget(__("apk", "docks"), p)
+{
+    _connections << connect(this, SIGNAL(apkDecode(QString)), p, SLOT(onOpenApk(QString)));
+    _connections << connect(this, SIGNAL(fileOpen(QString)), p, SLOT(onFileOpen(QString)));
+    _connections << connect(p, SIGNAL(apkBrowse(QString)), this, SLOT(onApkBrowse(QString)));
+    _tree = new QTreeWidget(this);
+    _tree->setColumnCount(2);
+    _tree->setContextMenuPolicy(Qt::CustomContextMenu);
+    _tree->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    _tree->setSelectionMode(QAbstractItemView::SingleSelection);
+    _tree->setUniformRowHeights(true);
+    _tree->header()->hide();
+    _tree->header()->setStretchLastSection(false);
+    _tree->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    _tree->header()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+    _connections << connect(_tree, &QTreeWidget::customContextMenuRequested, this, &ApkDock::onContextMenuRequested);
+    _connections << connect(_tree, &QTreeWidget::itemActivated, this, &ApkDock::onItemActivated);
+    setContentsMargins(2, 2, 2, 2);
+    setObjectName("ApkDock");
+    setWidget(_tree);
+}
+
+/**
+ * @brief Inflates the entry under a scratch folder named after the APK, and
+ * reuses it while the APK is unchanged. Compiled XML is written as text.
+ */
+QString ApkDock::extract(const int i)
+{
+    const QString dir = scratch();
+    const QString path = QDir::cleanPath(PathUtils::combine(dir, _reader.entry(i).name));
+    if (!path.startsWith(dir + '/'))
+    {
+        // Names like "../x" are not written anywhere
+        return QString();
+    }
+    const QString name = _reader.entry(i).name;
+    const bool xml = name.endsWith(".xml", Qt::CaseInsensitive) && ((name == "AndroidManifest.xml") || name.startsWith("res/"));
+    if (!xml && (QFileInfo(path).size() == qint64(_reader.entry(i).size)))
+    {
+        return path;
+    }
+    QSaveFile file(path);
+    if (!QDir().mkpath(QFileInfo(path).absolutePath()) || !file.open(QIODevice::WriteOnly))
+    {
+        return QString();
+    }
+    if (xml)
+    {
+        QByteArray buffer;
+        const uchar *data = _reader.data(i);
+        qint64 size = qint64(_reader.entry(i).size);
+        if (!data)
+        {
+            buffer = _reader.read(i);
+            data = reinterpret_cast<const uchar *>(buffer.constData());
+            size = buffer.size();
+        }
+        if (AxmlDecoder::isBinary(data, size))
+        {
+            file.write(AxmlDecoder(data, size).toXml().toUtf8());
+        }
+        else
+        {
+            file.write(reinterpret_cast<const char *>(data), size);
+        }
+        return ((size == qint64(_reader.entry(i).size)) && file.commit()) ? path : QString();
+    }
+    return (_reader.extract(i, &file) && file.commit()) ? path : QString();
+}
+
+/**
+ * @brief Scratch folder of the current APK, named after its path, size and
+ * time.
+ */
+QString ApkDock::scratch() const
+{
+    const QFileInfo apk(_apk);
+    const QString key = QString("%1|%2|%3").arg(apk.absoluteFilePath()).arg(apk.size()).arg(apk.lastModified().toMSecsSinceEpoch());
+    return PathUtils::combine(QDir::tempPath(), QString("apkstudio-") + QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex().left(12));
+}
+
+/**
+ * @brief Orders a folder and everything under it the way the project dock
+ * lists files: folders first, each group by name.
+ */
+static void sortItems(QTreeWidgetItem *parent)
+{
+    QList<QTreeWidgetItem *> children = parent->takeChildren();
+    std::sort(children.begin(), children.end(), [](const QTreeWidgetItem *a, const QTreeWidgetItem *b) {
+        const bool da = a->data(0, ApkDock::RoleEntry).toInt() < 0;
+        const bool db = b->data(0, ApkDock::RoleEntry).toInt() < 0;
+        return (da != db) ? da : (a->text(0) < b->text(0));
+    });
+    parent->addChildren(children);
+    foreach (QTreeWidgetItem *child, children)
+    {
+        if (child->data(0, ApkDock::RoleEntry).toInt() < 0)
+        {
+            sortItems(child);
+        }
+    }
+}
+
+void ApkDock::onApkBrowse(const QString &a)
+{
+    _tree->clear();
+    _apk.clear();
+    if (!_reader.open(a))
+    {
+        QMessageBox::warning(this, __("invalid_apk", "titles"), __("invalid_apk", "messages", a), QMessageBox::Close);
+        return;
+    }
+    _apk = a;
+    QFile marker(PathUtils::combine(scratch(), FILE_APK_SOURCE));
+    if (QDir().mkpath(scratch()) && marker.open(QIODevice::WriteOnly))
+    {
+        marker.write(QFileInfo(a).absoluteFilePath().toUtf8());
+        marker.close();
+    }
+    const QIcon folder = _provider.icon(QFileIconProvider::Folder);
+    QHash<QString, QIcon> icons;
+    QHash<QString, QTreeWidgetItem *> dirs;
+    QTreeWidgetItem *root = new QTreeWidgetItem(_tree, QStringList(QFileInfo(a).fileName()));
+    root->setIcon(0, Qrc::icon("toolbar_apk"));
+    root->setToolTip(0, a);
+    for (int i = 0; i < _reader.entryCount(); i++)
+    {
+        const ZipReader::Entry &e = _reader.entry(i);
+        const int slash = e.name.lastIndexOf('/');
+        QTreeWidgetItem *parent = root;
+        if (slash > 0)
+        {
+            // Parent folders are created on the way, archives need not list them
+            const QString dir = e.name.left(slash);
+            QStringList path;
+            foreach (const QString &part, dir.split('/', QString::SkipEmptyParts))
+            {
+                path << part;
+                const QString key = path.join('/');
+                QTreeWidgetItem *item = dirs.value(key);
+                if (!item)
+                {
+                    item = new QTreeWidgetItem(parent, QStringList(part));
+                    item->setIcon(0, folder);
+                    item->setData(0, RoleEntry, -1);
+                    dirs.insert(key, item);
+                }
+                parent = item;
+            }
+        }
+        const QString name = e.name.mid(slash + 1);
+        const QString suffix = QFileInfo(name).suffix().toLower();
+        QHash<QString, QIcon>::const_iterator icon = icons.constFind(suffix);
+        if (icon == icons.constEnd())
+        {
+            icon = icons.insert(suffix, _provider.icon(QFileInfo(name)));
+        }
+        QTreeWidgetItem *item = new QTreeWidgetItem(parent, QStringList() << name << sizeText(e.size));
+        item->setData(0, RoleEntry, i);
+        item->setIcon(0, icon.value());
+        item->setTextAlignment(1, Qt::AlignRight | Qt::AlignVCenter);
+        item->setToolTip(0, e.name);
+    }
+    sortItems(root);
+    root->setExpanded(true);
+    show();
+    raise();
+    const int manifest = _reader.find("AndroidManifest.xml");
+    QString path;
+    if ((manifest >= 0) && !(path = extract(manifest)).isEmpty())
+    {
+        emit fileOpen(path);
+    }
+}
+
+void ApkDock::onContextMenuRequested(const QPoint &p)
+{
+    if (_apk.isEmpty())
+    {
+        return;
+    }
+    QTreeWidgetItem *item = _tree->itemAt(p);
+    QMenu menu(this);
+    QAction *open = menu.addAction(__("open", "archive"));
+    QAction *decode = menu.addAction(__("decode", "archive"));
+    QAction *summary = menu.addAction(__("dex_summary", "archive"));
+    open->setEnabled(item && (item->data(0, RoleEntry).toInt() >= 0) && (item != _tree->topLevelItem(0)));
+    QAction *chosen = menu.exec(_tree->viewport()->mapToGlobal(p));
+    if (chosen == open)
+    {
+        onItemActivated(item);
+    }
+    else if (chosen == decode)
+    {
+        emit apkDecode(_apk);
+    }
+    else if (chosen == summary)
+    {
+        DexSummary::display(_apk, this);
+    }
+}
+
+void ApkDock::onItemActivated(QTreeWidgetItem *item)
+{
+    if (!item || (item == _tree->topLevelItem(0)))
+    {
+        return;
+    }
+    const int i = item->data(0, RoleEntry).toInt();
+    if (i < 0)
+    {
+        return;
+    }
+    const QString path = extract(i);
+    if (path.isEmpty())
+    {
+        QMessageBox::warning(this, __("invalid_apk", "titles"), __("extract_failure", "messages", _reader.entry(i).name), QMessageBox::Close);
+        return;
+    }
+    emit fileOpen(path);
+}
+
+ApkDock::~ApkDock()
+{
+    APP_CONNECTIONS_DISCONNECT
+}
+
+APP_NAMESPACE_END
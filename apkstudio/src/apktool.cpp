@@ -13,9 +13,17 @@ ApkTool::ApkTool(QObject *parent)
     _jar = PathUtils::find("apktool.jar");
 }
 
-Process::Result ApkTool::build(const QString &p, const QString &a)
+/**
+ * @brief Without force apktool keeps the build folder and only rebuilds the
+ * dex files and resources whose inputs are newer than what it built before.
+ */
+Process::Result ApkTool::build(const QString &p, const QString &a, const bool f)
 {
-    return exec(QStringList("-f") << "b" << p << "-o" << a);
+    QStringList args;
+    if (f)
+    { args << "-f"; }
+    args << "b" << p << "-o" << a;
+    return exec(args);
 }
 
 Process::Result ApkTool::decode(const QString &a, const QString &p, const QString &f, const bool s, const bool r)
@@ -33,7 +41,7 @@ Process::Result ApkTool::decode(const QString &a, const QString &p, const QStrin
 
 Process::Result ApkTool::exec(const QStringList &a)
 {
-    return Java::exec(QStringList("-jar") << _jar << a);
+    return execJar(_jar, a);
 }
 
 ApkTool *ApkTool::get()
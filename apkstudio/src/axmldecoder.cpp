@@ -0,0 +1,297 @@
+#include <cstring>
+#include <QHash>
+#include <QStringList>
+#include <QtEndian>
+#include "include/axmldecoder.h"
+
+APP_NAMESPACE_START
+
+enum ChunkType
+{
+    ChunkStringPool = 0x0001,
+    ChunkXml = 0x0003,
+    ChunkStartNamespace = 0x0100,
+    ChunkEndNamespace = 0x0101,
+    ChunkStartElement = 0x0102,
+    ChunkEndElement = 0x0103,
+    ChunkCdata = 0x0104,
+    ChunkResourceMap = 0x0180
+};
+
+enum ValueType
+{
+    ValueNull = 0x00,
+    ValueReference = 0x01,
+    ValueAttribute = 0x02,
+    ValueString = 0x03,
+    ValueFloat = 0x04,
+    ValueDimension = 0x05,
+    ValueFraction = 0x06,
+    ValueDynamicReference = 0x07,
+    ValueIntDec = 0x10,
+    ValueIntHex = 0x11,
+    ValueIntBoolean = 0x12,
+    ValueColorArgb8 = 0x1c,
+    ValueColorRgb8 = 0x1d,
+    ValueColorArgb4 = 0x1e,
+    ValueColorRgb4 = 0x1f
+};
+
+static const quint32 none = 0xffffffff;
+
+static inline quint16 u16(const uchar *p)
+{
+    return qFromLittleEndian<quint16>(p);
+}
+
+static inline quint32 u32(const uchar *p)
+{
+    return qFromLittleEndian<quint32>(p);
+}
+
+static QString escape(const QString &s)
+{
+    QString e;
+    e.reserve(s.size());
+    foreach (const QChar c, s)
+    {
+        switch (c.unicode())
+        {
+        case '&':
+            e.append("&amp;");
+            break;
+        case '<':
+            e.append("&lt;");
+            break;
+        case '>':
+            e.append("&gt;");
+            break;
+        case '"':
+            e.append("&quot;");
+            break;
+        case '\n':
+            e.append("&#10;");
+            break;
+        default:
+            e.append(c);
+        }
+    }
+    return e;
+}
+
+/**
+ * @brief Value of a complex (dimension or fraction): 24 bits of mantissa and
+ * a radix telling where its point is.
+ */
+static double complexValue(const quint32 d)
+{
+    static const double radix[] = {1.0 / (1 << 8), 1.0 / (1 << 15), 1.0 / (1 << 23), 1.0 / (quint64(1) << 31)};
+    return double(qint32(d & 0xffffff00)) * radix[(d >> 4) & 3];
+}
+
+AxmlDecoder::AxmlDecoder(const uchar *d, const qint64 s)
+    : _data(d), _resources(0), _resourceCount(0), _size(s)
+{
+}
+
+/**
+ * @brief Obfuscated apps often blank the names of framework attributes; the
+ * resource map still tells which attribute it is.
+ */
+QString AxmlDecoder::attributeName(const quint32 n) const
+{
+    const QString name = string(n);
+    if (!name.isEmpty() || (n >= quint32(_resourceCount)))
+    {
+        return name;
+    }
+    return QString("attr_0x%1").arg(u32(_resources + (n * 4)), 8, 16, QChar('0'));
+}
+
+bool AxmlDecoder::isBinary(const uchar *d, const qint64 s)
+{
+    return d && (s >= 8) && (u16(d) == ChunkXml) && (u16(d + 2) == 8);
+}
+
+QString AxmlDecoder::string(const quint32 i) const
+{
+    return (i == none) ? QString() : _strings.at(i);
+}
+
+/**
+ * @brief Walks the chunks once, writing elements as they open and close.
+ * Namespaces are declared on the element that follows their start chunk.
+ */
+QString AxmlDecoder::toXml()
+{
+    if (!isBinary(_data, _size))
+    {
+        return QString();
+    }
+    const qint64 size = qMin<qint64>(_size, u32(_data + 4));
+    QString xml("<?xml version=\"1.0\" encoding=\"utf-8\"?>\n");
+    QHash<QString, QString> prefixes;
+    QStringList pending;
+    int depth = 0;
+    bool open = false;
+    for (qint64 at = 8; (at + 8) <= size; )
+    {
+        const uchar *chunk = _data + at;
+        const quint16 type = u16(chunk);
+        const quint16 header = u16(chunk + 2);
+        const quint32 length = u32(chunk + 4);
+        if ((length < 8) || ((at + length) > size) || (header > length))
+        {
+            break;
+        }
+        const uchar *ext = chunk + header;
+        switch (type)
+        {
+        case ChunkStringPool:
+            _strings.read(chunk, length);
+            break;
+        case ChunkResourceMap:
+            _resources = ext;
+            _resourceCount = int((length - header) / 4);
+            break;
+        case ChunkStartNamespace:
+            if ((length - header) >= 8)
+            {
+                const QString prefix = string(u32(ext));
+                const QString uri = string(u32(ext + 4));
+                prefixes.insert(uri, prefix);
+                pending << QString(" xmlns:%1=\"%2\"").arg(prefix, escape(uri));
+            }
+            break;
+        case ChunkStartElement:
+            if ((length - header) >= 20)
+            {
+                if (open)
+                {
+                    xml.append(">\n");
+                }
+                const QString name = string(u32(ext + 4));
+                const quint16 start = u16(ext + 8);
+                const quint16 stride = u16(ext + 10);
+                const quint16 count = u16(ext + 12);
+                xml.append(QString(depth * 4, ' ')).append('<').append(name);
+                foreach (const QString &ns, pending)
+                {
+                    xml.append(ns);
+                }
+                pending.clear();
+                // URIs without a start chunk get a prefix declared right on this element
+                QHash<QString, QString> undeclared;
+                for (int a = 0; (a < count) && (stride >= 20); a++)
+                {
+                    const uchar *attr = ext + start + (a * stride);
+                    if ((attr + 20) > (chunk + length))
+                    {
+                        break;
+                    }
+                    const QString uri = string(u32(attr));
+                    QString prefix = prefixes.value(uri);
+                    if (prefix.isEmpty() && !uri.isEmpty())
+                    {
+                        prefix = undeclared.value(uri);
+                        if (prefix.isEmpty())
+                        {
+                            undeclared.insert(uri, prefix = QString("ns%1").arg(undeclared.size()));
+                        }
+                    }
+                    const quint32 raw = u32(attr + 8);
+                    const QString v = (raw != none) ? string(raw) : value(attr[15], u32(attr + 16), _strings);
+                    xml.append(QString("\n%1%2%3=\"%4\"").arg(QString((depth + 1) * 4, ' '),
+                                                                 prefix.isEmpty() ? QString() : (prefix + ':'),
+                                                                 attributeName(u32(attr + 4)),
+                                                                 escape(v)));
+                }
+                for (QHash<QString, QString>::const_iterator it = undeclared.constBegin(); it != undeclared.constEnd(); ++it)
+                {
+                    xml.append(QString("\n%1xmlns:%2=\"%3\"").arg(QString((depth + 1) * 4, ' '), it.value(), escape(it.key())));
+                }
+                open = true;
+                depth++;
+            }
+            break;
+        case ChunkEndElement:
+            if ((length - header) >= 8)
+            {
+                depth = qMax(0, depth - 1);
+                if (open)
+                {
+                    xml.append(" />\n");
+                }
+                else
+                {
+                    xml.append(QString(depth * 4, ' ')).append("</").append(string(u32(ext + 4))).append(">\n");
+                }
+                open = false;
+            }
+            break;
+        case ChunkCdata:
+            if ((length - header) >= 4)
+            {
+                if (open)
+                {
+                    xml.append(">\n");
+                    open = false;
+                }
+                xml.append(QString(depth * 4, ' ')).append(escape(string(u32(ext)))).append('\n');
+            }
+            break;
+        default:
+            break;
+        }
+        at += length;
+    }
+    return xml;
+}
+
+/**
+ * @brief Text of a Res_value, shared with resources.arsc which encodes them
+ * the same way.
+ */
+QString AxmlDecoder::value(const quint8 type, const quint32 d, const StringPool &strings)
+{
+    switch (type)
+    {
+    case ValueNull:
+        return QString();
+    case ValueReference:
+    case ValueDynamicReference:
+        return (d == 0) ? QString("@null") : QString("@0x%1").arg(d, 8, 16, QChar('0'));
+    case ValueAttribute:
+        return QString("?0x%1").arg(d, 8, 16, QChar('0'));
+    case ValueString:
+        return strings.at(d);
+    case ValueFloat:
+    {
+        float f;
+        memcpy(&f, &d, sizeof(f));
+        return QString::number(double(f));
+    }
+    case ValueDimension:
+    {
+        static const char *units[] = {"px", "dip", "sp", "pt", "in", "mm"};
+        const quint32 unit = d & 0xf;
+        return QString::number(complexValue(d)) + ((unit < 6) ? units[unit] : "");
+    }
+    case ValueFraction:
+        return QString::number(complexValue(d) * 100) + (((d & 0xf) == 1) ? "%p" : "%");
+    case ValueIntHex:
+        return QString("0x%1").arg(d, 8, 16, QChar('0'));
+    case ValueIntBoolean:
+        return d ? QString("true") : QString("false");
+    case ValueColorArgb8:
+    case ValueColorRgb8:
+    case ValueColorArgb4:
+    case ValueColorRgb4:
+        return QString("#%1").arg(d, 8, 16, QChar('0'));
+    case ValueIntDec:
+    default:
+        return QString::number(qint32(d));
+    }
+}
+
+APP_NAMESPACE_END
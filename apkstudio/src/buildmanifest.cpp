@@ -0,0 +1,157 @@
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QSaveFile>
+#include "include/buildmanifest.h"
+#include "include/constants.h"
+#include "include/pathutils.h"
+
+APP_NAMESPACE_START
+
+BuildManifest::BuildManifest(const QString &p)
+    : _project(p)
+{
+}
+
+/**
+ * @brief Top level entry of a project relative path; empty for what apktool
+ * does not build from, i.e. its own output and dot files.
+ */
+QString BuildManifest::group(const QString &p)
+{
+    const QString top = p.section('/', 0, 0);
+    if (top.isEmpty() || top.startsWith('.') || (top == "build") || (top == "dist"))
+    {
+        return QString();
+    }
+    return top;
+}
+
+bool BuildManifest::load()
+{
+    QFile file(PathUtils::combine(_project, FILE_BUILD_MANIFEST));
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    QByteArray magic;
+    quint32 version;
+    quint32 count;
+    stream >> magic >> version;
+    if ((magic != BUILD_MANIFEST_MAGIC) || (version != BUILD_MANIFEST_VERSION))
+    {
+        return false;
+    }
+    stream >> _pending >> count;
+    for (quint32 i = 0; (i < count) && (stream.status() == QDataStream::Ok); i++)
+    {
+        QString path;
+        Entry e;
+        stream >> path >> e.modified >> e.size >> e.hash;
+        _entries.insert(path, e);
+    }
+    if (stream.status() != QDataStream::Ok)
+    {
+        _entries.clear();
+        _pending.clear();
+        return false;
+    }
+    return true;
+}
+
+bool BuildManifest::save()
+{
+    QSaveFile file(PathUtils::combine(_project, FILE_BUILD_MANIFEST));
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << QByteArray(BUILD_MANIFEST_MAGIC) << quint32(BUILD_MANIFEST_VERSION);
+    stream << _pending << quint32(_entries.size());
+    for (QHash<QString, Entry>::const_iterator it = _entries.constBegin(); it != _entries.constEnd(); ++it)
+    {
+        stream << it.key() << it->modified << it->size << it->hash;
+    }
+    return file.commit();
+}
+
+/**
+ * @brief Brings the hashes up to date and returns the groups that changed
+ * since the last finished build, including the ones that went away. Hinted
+ * paths, i.e. files saved in the editor, are hashed even when their time and
+ * size look unchanged.
+ */
+QSet<QString> BuildManifest::update(const QSet<QString> &h)
+{
+    const QDir root(_project);
+    QSet<QString> hints;
+    foreach (const QString &p, h)
+    {
+        hints << root.relativeFilePath(p);
+    }
+    QSet<QString> changed = _pending;
+    QFileInfoList files;
+    foreach (const QFileInfo &top, root.entryInfoList(QDir::AllEntries | QDir::Hidden | QDir::NoDotAndDotDot))
+    {
+        if (group(top.fileName()).isEmpty())
+        {
+            continue;
+        }
+        if (!top.isDir())
+        {
+            files << top;
+            continue;
+        }
+        QDirIterator it(top.filePath(), QDir::Files | QDir::Hidden | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+        while (it.hasNext())
+        {
+            it.next();
+            files << it.fileInfo();
+        }
+    }
+    QHash<QString, Entry> entries;
+    foreach (const QFileInfo &info, files)
+    {
+        const QString path = root.relativeFilePath(info.filePath());
+        const QString g = group(path);
+        Entry e = {QByteArray(), info.lastModified().toMSecsSinceEpoch(), info.size()};
+        QHash<QString, Entry>::const_iterator old = _entries.constFind(path);
+        if ((old != _entries.constEnd()) && (old->modified == e.modified) && (old->size == e.size) && !hints.contains(path))
+        {
+            e.hash = old->hash;
+        }
+        else
+        {
+            QFile file(info.filePath());
+            QCryptographicHash hash(QCryptographicHash::Sha1);
+            if (file.open(QIODevice::ReadOnly))
+            {
+                hash.addData(&file);
+            }
+            e.hash = hash.result();
+            if ((old == _entries.constEnd()) || (old->hash != e.hash))
+            {
+                changed << g;
+            }
+        }
+        entries.insert(path, e);
+    }
+    for (QHash<QString, Entry>::const_iterator old = _entries.constBegin(); old != _entries.constEnd(); ++old)
+    {
+        if (!entries.contains(old.key()))
+        {
+            changed << group(old.key());
+        }
+    }
+    _entries = entries;
+    return changed;
+}
+
+APP_NAMESPACE_END
@@ -1,28 +1,79 @@
+#include <QFile>
+#include <QFileInfo>
+#include "include/buildmanifest.h"
 #include "include/buildrunnable.h"
 #include "include/apktool.h"
+#include "include/constants.h"
+#include "include/fileutils.h"
+#include "include/pathutils.h"
+#include "include/qrc.h"
 
 APP_NAMESPACE_START
 
-BuildRunnable::BuildRunnable(const QString &p, const QString &a, QObject *o)
-    : Runnable(o), _apk(a), _project(p)
+BuildRunnable::BuildRunnable(const QString &p, const QString &a, const QSet<QString> &h, QObject *o)
+    : Runnable(__("build", "jobs", QFileInfo(p).fileName()), RUNNER_RESOURCE_JAVA, o), _apk(a), _hints(h), _project(p)
 {
     _connections << connect(this, SIGNAL(buildFailure(QString)), o, SLOT(onBuildFailure(QString)), Qt::QueuedConnection);
     _connections << connect(this, SIGNAL(buildSuccess(QString)), o, SLOT(onBuildSuccess(QString)), Qt::QueuedConnection);
 }
 
-void BuildRunnable::run()
+/**
+ * @brief Builds incrementally unless the manifest is missing, apktool.yml
+ * changed or a group went away; those need a clean build folder.
+ */
+bool BuildRunnable::execute()
 {
-    emit runnableStarted();
-    Process::Result r = ApkTool::get()->build(_project, _apk);
+    BuildManifest manifest(_project);
+    const bool known = manifest.load();
+    const QSet<QString> changed = manifest.update(_hints);
+    const bool force = !known || !invalidate(changed);
+    manifest.setPending(force ? QSet<QString>() << "apktool.yml" : changed);
+    manifest.save();
+    Process::Result r = ApkTool::get()->build(_project, _apk, force);
     if (r.code == 0)
     {
+        manifest.setPending(QSet<QString>());
+        manifest.save();
         emit buildSuccess(_apk);
+        return true;
     }
-    else
+    emit buildFailure(_project);
+    return false;
+}
+
+/**
+ * @brief Removes what apktool built from the changed groups so it cannot keep
+ * them on timestamps alone. False when only a clean build will do.
+ */
+bool BuildRunnable::invalidate(const QSet<QString> &groups)
+{
+    const QString apk = PathUtils::combine(_project, "build/apk");
+    foreach (const QString &g, groups)
     {
-        emit buildFailure(_project);
+        if ((g == "apktool.yml") || !QFileInfo::exists(PathUtils::combine(_project, g)))
+        {
+            return false;
+        }
+        if (g == "smali")
+        {
+            QFile::remove(PathUtils::combine(apk, "classes.dex"));
+        }
+        else if (g.startsWith("smali_"))
+        {
+            QFile::remove(PathUtils::combine(apk, g.mid(6) + ".dex"));
+        }
+        else if ((g == "res") || (g == "AndroidManifest.xml"))
+        {
+            QFile::remove(PathUtils::combine(apk, "resources.arsc"));
+            QFile::remove(PathUtils::combine(apk, "AndroidManifest.xml"));
+            if (g == "res")
+            {
+                // Compiled resources are copied over build/apk without clearing it, deleted ones would ship
+                FileUtils::rimraf(PathUtils::combine(apk, "res"));
+            }
+        }
     }
-    emit runnableStopped();
+    return true;
 }
 
 APP_NAMESPACE_END
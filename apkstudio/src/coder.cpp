@@ -7,13 +7,14 @@
 #include <QToolTip>
 #include "include/coder.h"
 #include "include/codersidebar.h"
+#include "include/constants.h"
 #include "include/fileutils.h"
 #include "include/preferences.h"
 
 APP_NAMESPACE_START
 
 Coder::Coder(QWidget *parent) :
-    QPlainTextEdit(parent)
+    QPlainTextEdit(parent), _loadingOffset(0), _viewportFirst(-1), _viewportLast(-1)
 {
     _connections << connect(this, SIGNAL(blockCountChanged(int)), this, SLOT(onUpdateMargins(int)));
     _connections << connect(this, SIGNAL(cursorPositionChanged()), this, SLOT(onCursorPositionChanged()));
@@ -185,6 +186,26 @@ void Coder::gotoLineStart()
     }
 }
 
+/**
+ * @brief Shows the first screen right away and appends the rest in chunks from the event loop.
+ */
+void Coder::load(const QString &text)
+{
+    int n = text.indexOf('\n', EDITOR_LOAD_CHUNK);
+    if ((n < 0) || ((n + 1) >= text.size()))
+    {
+        setPlainText(text);
+        emit loaded();
+        return;
+    }
+    _loading = text;
+    _loadingOffset = n + 1;
+    setReadOnly(true);
+    setPlainText(text.left(_loadingOffset));
+    document()->setUndoRedoEnabled(false);
+    QTimer::singleShot(0, this, SLOT(onLoadMore()));
+}
+
 void Coder::onCursorPositionChanged()
 {
     QList<QTextEdit::ExtraSelection> selections;
@@ -208,6 +229,28 @@ void Coder::onInit()
     onUpdateMargins(0);
 }
 
+void Coder::onLoadMore()
+{
+    int n = _loading.indexOf('\n', _loadingOffset + EDITOR_LOAD_CHUNK);
+    n = (n < 0) ? _loading.size() : (n + 1);
+    QTextCursor c(document());
+    c.movePosition(QTextCursor::End);
+    c.insertText(_loading.mid(_loadingOffset, n - _loadingOffset));
+    _loadingOffset = n;
+    if (_loadingOffset < _loading.size())
+    {
+        QTimer::singleShot(0, this, SLOT(onLoadMore()));
+        return;
+    }
+    _loading.clear();
+    _loadingOffset = 0;
+    document()->setUndoRedoEnabled(true);
+    document()->setModified(false);
+    setReadOnly(false);
+    onCursorPositionChanged();
+    emit loaded();
+}
+
 void Coder::onUpdateRequest(const QRect &rect, const int column)
 {
     if (column)
@@ -215,6 +258,26 @@ void Coder::onUpdateRequest(const QRect &rect, const int column)
     _sidebar->update(0, rect.y(), _sidebar->width(), rect.height());
     if (rect.contains(viewport()->rect()))
     { onUpdateMargins(0); }
+    if (column || rect.contains(viewport()->rect()))
+    {
+        QTextBlock b = firstVisibleBlock();
+        const int first = b.blockNumber();
+        int last = first;
+        qreal top = blockBoundingGeometry(b).translated(contentOffset()).top();
+        const int bottom = viewport()->height();
+        while (b.isValid() && (top <= bottom))
+        {
+            last = b.blockNumber();
+            top += blockBoundingRect(b).height();
+            b = b.next();
+        }
+        if ((first != _viewportFirst) || (last != _viewportLast))
+        {
+            _viewportFirst = first;
+            _viewportLast = last;
+            emit viewportChanged(first, last);
+        }
+    }
 }
 
 bool Coder::indentText(const bool forward)
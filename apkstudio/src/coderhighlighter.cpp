@@ -1,78 +1,378 @@
+#include <QTextDocument>
+#include <QThreadPool>
+#include <QTimer>
 #include "include/coderhighlighter.h"
+#include "include/coderhighlighterworker.h"
 #include "include/constants.h"
-#include "include/preferences.h"
+#ifdef HIGHLIGHTER_BENCHMARK
+#include <QDebug>
+#include <QElapsedTimer>
+#endif
 
 APP_NAMESPACE_START
 
 CoderHighlighter::CoderHighlighter(const QString &d, const QString &t, QTextDocument *doc)
-    : QSyntaxHighlighter(doc)
+    : QSyntaxHighlighter(doc), _activeFirst(0), _activeGuessed(false), _activeLast(-1), _activePrevious(0), _edited(-1), _generation(0), _lazy(false), _pending(0), _refreshing(false), _restarting(false), _tokenizer(CoderTokenizer::get(d, t)), _viewportFirst(0), _viewportLast(-1)
 {
-    _definition = new CoderHighlighterDefinition(QString(QRC_HIGHLIGHT).arg(d));
-    _theme = new CoderHighlighterTheme(QString(QRC_HIGHLIGHT).arg(t));
-    if (Preferences::get()->showWhitespaces())
+#ifdef HIGHLIGHTER_BENCHMARK
+    _blocks = 0;
+    _elapsed = 0;
+#endif
+    _checkpoints << 0;
+    if (doc && (doc->blockCount() >= HIGHLIGHTER_LAZY_BLOCKS))
     {
-        CoderHighlighterDefinitionEntry e;
-        e.regex = REGEX_WHITESPACE;
-        e.style = HIGHLIGHTER_STYLE_WHITESPACES;
-        *_definition << e;
+        // Only blocks around the viewport get formats, the worker just records states
+        _lazy = true;
+        connect(doc, &QTextDocument::contentsChange, this, &CoderHighlighter::onContentsChange);
+        start(0);
+    }
+    else if (doc && (doc->blockCount() >= HIGHLIGHTER_THREADED_BLOCKS))
+    {
+        // Blocks are skipped until tokens arrive, so the rehighlight queued by setDocument() stays cheap
+        start(0);
+    }
+}
+
+void CoderHighlighter::apply(const CoderTokenList &tokens)
+{
+    const CoderHighlighterDefinitionEntryList &entries = _tokenizer->definition()->entries();
+    foreach (const CoderToken &token, tokens)
+    {
+        setFormat(token.start, token.length, entries.at(token.entry).format);
     }
 }
 
 void CoderHighlighter::highlightBlock(const QString &t)
 {
-    foreach (const CoderHighlighterDefinitionEntry &d, _definition->entries())
+#ifdef HIGHLIGHTER_BENCHMARK
+    QElapsedTimer timer;
+    timer.start();
+#endif
+    if (_lazy)
+    {
+        highlightVisible(t);
+    }
+    else
+    {
+        highlightCached(t);
+    }
+#ifdef HIGHLIGHTER_BENCHMARK
+    _elapsed += timer.nsecsElapsed();
+    if ((++_blocks % 1000) == 0)
+    {
+        qDebug() << "highlightBlock:" << (_elapsed / _blocks) << "ns/block over" << _blocks << "blocks";
+    }
+#endif
+}
+
+void CoderHighlighter::highlightCached(const QString &t)
+{
+    const QTextBlock block = currentBlock();
+    const int previous = qMax(previousBlockState(), 0);
+    CoderHighlighterBlockData *data = static_cast<CoderHighlighterBlockData *>(currentBlockUserData());
+    if (data && (data->revision == block.revision()) && (data->previous == previous))
+    {
+        apply(data->tokens);
+        setCurrentBlockState(data->state);
+    }
+    else if (_worker && (block.blockNumber() >= _pending))
+    {
+        // Tokens for this block are on their way, keep the state so nothing cascades
+        setCurrentBlockState(block.userState());
+    }
+    else
+    {
+        _tokens.resize(0);
+        const int state = _tokenizer->tokenize(t, previous, _tokens);
+        setCurrentBlockState(state);
+        apply(_tokens);
+        if (data)
+        {
+            data->previous = previous;
+            data->revision = block.revision();
+            data->state = state;
+            data->tokens = _tokens;
+        }
+    }
+}
+
+void CoderHighlighter::highlightVisible(const QString &t)
+{
+    const QTextBlock block = currentBlock();
+    const int n = block.blockNumber();
+    if ((n < _activeFirst) || (n > _activeLast))
+    {
+        // Far from the viewport: no formats, and keep the state so nothing cascades
+        setCurrentBlockState(block.userState());
+        return;
+    }
+    const int previous = (n == _activeFirst) ? _activePrevious : qMax(previousBlockState(), 0);
+    _tokens.resize(0);
+    const int state = _tokenizer->tokenize(t, previous, _tokens);
+    if (!_refreshing && (block.userState() >= 0) && (block.userState() != state))
+    {
+        // An edit changed what follows, checkpoints below it are stale
+        invalidate(n);
+    }
+    setCurrentBlockState(state);
+    apply(_tokens);
+}
+
+void CoderHighlighter::invalidate(const int block)
+{
+    const int c = (block / HIGHLIGHTER_CHECKPOINT_BLOCKS) + 1;
+    if (c < _checkpoints.size())
+    {
+        _checkpoints.resize(c);
+    }
+    if (!_restarting)
+    {
+        // Snapshotting a huge document is not free, wait for typing to settle
+        _restarting = true;
+        QTimer::singleShot(HIGHLIGHTER_LAZY_DELAY, this, SLOT(onRestart()));
+    }
+}
+
+void CoderHighlighter::onBlockCountChanged(const int count)
+{
+    Q_UNUSED(count)
+    if (_lazy)
+    {
+        // Lines moved, checkpoints below the edit no longer line up
+        const QTextBlock b = document()->findBlock(qMax(_edited, 0));
+        invalidate(b.isValid() ? b.blockNumber() : 0);
+        _edited = -1;
+    }
+    else if (_worker && !_restarting)
+    {
+        _restarting = true;
+        QTimer::singleShot(0, this, SLOT(onRestart()));
+    }
+}
+
+void CoderHighlighter::onChunkReady(const CoderHighlighterChunk &c)
+{
+    if (c.generation != _generation)
     {
-        if (!d.regex.isNull() && !d.regex.isEmpty())
+        return;
+    }
+    if (_lazy)
+    {
+        for (int i = 0; i < c.states.size(); i++)
         {
-            if (d.multiline)
+            const int block = c.first + i + 1;
+            if (((block % HIGHLIGHTER_CHECKPOINT_BLOCKS) == 0) && ((block / HIGHLIGHTER_CHECKPOINT_BLOCKS) == _checkpoints.size()))
             {
-                QStringList p = d.regex.split('|');
-                QRegularExpression br(p.first());
-                QRegularExpression er(p.last());
-                setCurrentBlockState(0);
-                int b = 0;
-                if (previousBlockState() != 1)
-                {
-                    b = br.match(t).capturedStart();
-                }
-                while (b >= 0)
-                {
-                    QRegularExpressionMatch m = er.match(t, b);
-                    int e = m.capturedStart();
-                    int l;
-                    if (e == -1)
-                    {
-                        setCurrentBlockState(1);
-                        l = (t.length() - b);
-                    }
-                    else
-                    {
-                        l = ((e - b) + m.capturedLength());
-                    }
-                    setFormat(b, l, _theme->styles().value(d.style));
-                    b = br.match(t, (b + l)).capturedStart();
-                }
+                _checkpoints << c.states.at(i);
             }
-            else
+        }
+        if (_activeGuessed && ((_activeFirst / HIGHLIGHTER_CHECKPOINT_BLOCKS) < _checkpoints.size()))
+        {
+            refresh(true);
+        }
+        if (_worker)
+        {
+            _worker->release();
+        }
+        return;
+    }
+    QList<QTextBlock> blocks;
+    QTextBlock b = document()->findBlockByNumber(c.first);
+    for (int i = 0; (i < c.states.size()) && b.isValid(); i++, b = b.next())
+    {
+        blocks << b;
+        if (b.revision() != c.revisions.at(i))
+        {
+            // Edited since the snapshot, highlightBlock() will tokenize it in place
+            continue;
+        }
+        CoderHighlighterBlockData *data = static_cast<CoderHighlighterBlockData *>(b.userData());
+        if (!data)
+        {
+            b.setUserData(data = new CoderHighlighterBlockData);
+        }
+        data->previous = (i == 0) ? c.previous : c.states.at(i - 1);
+        data->revision = c.revisions.at(i);
+        data->state = c.states.at(i);
+        data->tokens = c.tokens.at(i);
+    }
+    if (!c.guessed)
+    {
+        _pending = qMax(_pending, c.first + c.states.size());
+    }
+    foreach (const QTextBlock &block, blocks)
+    {
+        rehighlightBlock(block);
+    }
+    if (_worker)
+    {
+        _worker->release();
+    }
+}
+
+void CoderHighlighter::onContentsChange(const int position, const int removed, const int added)
+{
+    if ((removed != added) && ((_edited < 0) || (position < _edited)))
+    {
+        _edited = position;
+    }
+}
+
+void CoderHighlighter::onRestart()
+{
+    _restarting = false;
+    if (_lazy)
+    {
+        // The worker snapshot may predate the edit, resume from the last valid checkpoint
+        start((_checkpoints.size() - 1) * HIGHLIGHTER_CHECKPOINT_BLOCKS);
+        return;
+    }
+    if (!_worker)
+    {
+        return;
+    }
+    // Resume from the first block whose tokens never arrived or went stale
+    QTextBlock b = document()->firstBlock();
+    while (b.isValid())
+    {
+        CoderHighlighterBlockData *data = static_cast<CoderHighlighterBlockData *>(b.userData());
+        if (!data || (data->revision != b.revision()))
+        {
+            break;
+        }
+        b = b.next();
+    }
+    start(b.isValid() ? b.blockNumber() : document()->blockCount());
+}
+
+void CoderHighlighter::onWorkerFinished(const int g)
+{
+    if (g == _generation)
+    {
+        _worker = 0;
+    }
+}
+
+void CoderHighlighter::refresh(const bool force)
+{
+    const int count = document()->blockCount();
+    const int wf = qMax(_viewportFirst - HIGHLIGHTER_LAZY_MARGIN, 0);
+    const int wl = qMin(_viewportLast + HIGHLIGHTER_LAZY_MARGIN, count - 1);
+    const int of = _activeFirst;
+    const int ol = _activeLast;
+    int af = wf;
+    int al = wl;
+    if (!force && (of <= ol) && (ol >= (wf - HIGHLIGHTER_LAZY_KEEP)) && (of <= (wl + HIGHLIGHTER_LAZY_KEEP)))
+    {
+        // Grow the formatted range while scrolling, but never beyond what is kept around the viewport
+        af = qMax(qMin(of, wf), wf - HIGHLIGHTER_LAZY_KEEP);
+        al = qMin(qMax(ol, wl), wl + HIGHLIGHTER_LAZY_KEEP);
+    }
+    _activeFirst = af;
+    _activeLast = al;
+    _refreshing = true;
+    if (of <= ol)
+    {
+        QTextBlock b = document()->findBlockByNumber(of);
+        for (int i = of; (i <= ol) && b.isValid(); i++, b = b.next())
+        {
+            if ((i < af) || (i > al))
             {
-                QRegularExpression r(d.regex);
-                QRegularExpressionMatch m = r.match(t);
-                while (m.hasMatch())
-                {
-                    int i = m.capturedStart();
-                    int l = m.capturedLength();
-                    setFormat(i, l, _theme->styles().value(d.style));
-                    m = r.match(t, i + l);
-                }
+                rehighlightBlock(b);
             }
         }
     }
+    if (force || (af != of))
+    {
+        _activePrevious = stateAt(af, _activeGuessed);
+    }
+    QTextBlock b = document()->findBlockByNumber(af);
+    for (int i = af; (i <= al) && b.isValid(); i++, b = b.next())
+    {
+        if (force || (i < of) || (i > ol))
+        {
+            rehighlightBlock(b);
+        }
+    }
+    _refreshing = false;
+}
+
+void CoderHighlighter::setViewport(const int first, const int last)
+{
+    if (_lazy)
+    {
+        _viewportFirst = first;
+        _viewportLast = last;
+        refresh(false);
+    }
+    else if (_worker)
+    {
+        _worker->prioritize(first, last);
+    }
+}
+
+void CoderHighlighter::start(const int block)
+{
+    if (_worker)
+    {
+        _worker->cancel();
+        _worker = 0;
+    }
+    _generation++;
+    _pending = block;
+    QTextDocument *doc = document();
+    QTextBlock b = doc->findBlockByNumber(block);
+    if (!b.isValid())
+    {
+        return;
+    }
+    const int state = _lazy
+            ? _checkpoints.value(block / HIGHLIGHTER_CHECKPOINT_BLOCKS)
+            : qMax(b.previous().isValid() ? b.previous().userState() : 0, 0);
+    QStringList lines;
+    QVector<int> revisions;
+    lines.reserve(doc->blockCount() - block);
+    revisions.reserve(doc->blockCount() - block);
+    for (; b.isValid(); b = b.next())
+    {
+        lines << b.text();
+        revisions << b.revision();
+    }
+    CoderHighlighterWorker *w = new CoderHighlighterWorker(_tokenizer, _generation, block, state, lines, revisions, !_lazy);
+    connect(w, &CoderHighlighterWorker::chunkReady, this, &CoderHighlighter::onChunkReady, Qt::QueuedConnection);
+    connect(w, &CoderHighlighterWorker::finished, this, &CoderHighlighter::onWorkerFinished, Qt::QueuedConnection);
+    connect(w, &CoderHighlighterWorker::finished, w, &CoderHighlighterWorker::deleteLater, Qt::QueuedConnection);
+    connect(doc, &QTextDocument::blockCountChanged, this, &CoderHighlighter::onBlockCountChanged, Qt::UniqueConnection);
+    _worker = w;
+    QThreadPool::globalInstance()->start(w);
+}
+
+int CoderHighlighter::stateAt(const int block, bool &guessed) const
+{
+    int c = qMin(block / HIGHLIGHTER_CHECKPOINT_BLOCKS, _checkpoints.size() - 1);
+    guessed = (block - (c * HIGHLIGHTER_CHECKPOINT_BLOCKS)) > HIGHLIGHTER_CHECKPOINT_BLOCKS;
+    if (guessed)
+    {
+        // Checkpoints have not reached this far yet, assume none and fix up when they do
+        return 0;
+    }
+    int state = _checkpoints.at(c);
+    CoderTokenList tokens;
+    QTextBlock b = document()->findBlockByNumber(c * HIGHLIGHTER_CHECKPOINT_BLOCKS);
+    for (int i = c * HIGHLIGHTER_CHECKPOINT_BLOCKS; (i < block) && b.isValid(); i++, b = b.next())
+    {
+        tokens.resize(0);
+        state = _tokenizer->tokenize(b.text(), state, tokens);
+    }
+    return state;
 }
 
 CoderHighlighter::~CoderHighlighter()
 {
-    delete _definition;
-    delete _theme;
+    if (_worker)
+    {
+        _worker->cancel();
+    }
 }
 
 APP_NAMESPACE_END
@@ -1,14 +1,19 @@
 #include <QFile>
 #include "include/constants.h"
 #include "include/coderhighlighterdefinition.h"
+#include "include/coderhighlightertheme.h"
 #include "include/fileutils.h"
+#include "include/lineindex.h"
+#include "include/preferences.h"
 
 APP_NAMESPACE_START
 
+QMap<QString, CoderHighlighterDefinition *> CoderHighlighterDefinition::_cache;
+
 CoderHighlighterDefinition::CoderHighlighterDefinition(const QString &p)
 {
     QString contents = FileUtils::read(p);
-    QStringList lines = contents.split(QRegularExpression(REGEX_LF), QString::SkipEmptyParts);
+    QStringList lines = LineIndex::split(contents);
     foreach (const QString l, lines)
     {
         QStringList p = l.split(QRegularExpression(REGEX_WHITESPACE), QString::SkipEmptyParts);
@@ -26,6 +31,53 @@ CoderHighlighterDefinition::CoderHighlighterDefinition(const QString &p)
     }
 }
 
+void CoderHighlighterDefinition::compile(const CoderHighlighterTheme &t)
+{
+    for (int i = 0; i < _entries.size(); i++)
+    {
+        CoderHighlighterDefinitionEntry &hde = _entries[i];
+        hde.format = t.styles().value(hde.style);
+        if (hde.regex.isEmpty())
+        {
+            continue;
+        }
+        if (hde.multiline)
+        {
+            QStringList p = hde.regex.split('|');
+            hde.begin.setPattern(p.first());
+            hde.begin.optimize();
+            hde.end.setPattern(p.last());
+            hde.end.optimize();
+        }
+        else
+        {
+            hde.pattern.setPattern(hde.regex);
+            hde.pattern.optimize();
+        }
+    }
+}
+
+const CoderHighlighterDefinition *CoderHighlighterDefinition::get(const QString &d, const QString &t)
+{
+    const bool ws = Preferences::get()->showWhitespaces();
+    const QString key = QString("%1|%2|%3").arg(d, t, ws ? "1" : "0");
+    CoderHighlighterDefinition *hd = _cache.value(key, NULL);
+    if (!hd)
+    {
+        hd = new CoderHighlighterDefinition(QString(QRC_HIGHLIGHT).arg(d));
+        if (ws)
+        {
+            CoderHighlighterDefinitionEntry e;
+            e.regex = REGEX_WHITESPACE;
+            e.style = HIGHLIGHTER_STYLE_WHITESPACES;
+            *hd << e;
+        }
+        hd->compile(CoderHighlighterTheme(QString(QRC_HIGHLIGHT).arg(t)));
+        _cache.insert(key, hd);
+    }
+    return hd;
+}
+
 CoderHighlighterDefinitionEntry CoderHighlighterDefinition::parse(const QString &k, const QString &v) const
 {
     CoderHighlighterDefinitionEntry hde;
@@ -3,13 +3,14 @@
 #include "include/constants.h"
 #include "include/coderhighlightertheme.h"
 #include "include/fileutils.h"
+#include "include/lineindex.h"
 
 APP_NAMESPACE_START
 
 CoderHighlighterTheme::CoderHighlighterTheme(const QString &p)
 {
     QString contents = FileUtils::read(p);
-    QStringList lines = contents.split(QRegularExpression(REGEX_LF), QString::SkipEmptyParts);
+    QStringList lines = LineIndex::split(contents);
     foreach (const QString l, lines)
     {
         QStringList p = l.split(QRegularExpression("\\s*=\\s*"), QString::SkipEmptyParts);
@@ -0,0 +1,92 @@
+#include "include/coderhighlighterworker.h"
+#include "include/constants.h"
+
+APP_NAMESPACE_START
+
+CoderHighlighterWorker::CoderHighlighterWorker(const CoderTokenizer *t, const int g, const int f, const int s, const QStringList &l, const QVector<int> &r, const bool k)
+    : QObject(0), _cancelled(0), _credits(HIGHLIGHTER_CHUNKS_IN_FLIGHT), _first(f), _generation(g), _lines(l), _priorityFirst(-1), _priorityLast(-1), _revisions(r), _state(s), _tokenizer(t), _tokens(k)
+{
+    setAutoDelete(false);
+}
+
+bool CoderHighlighterWorker::acquire()
+{
+    while (!_cancelled.load())
+    {
+        if (_credits.tryAcquire(1, 100))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void CoderHighlighterWorker::cancel()
+{
+    _cancelled.store(1);
+}
+
+void CoderHighlighterWorker::prioritize(const int f, const int l)
+{
+    _priorityLast.store(l);
+    _priorityFirst.store(f);
+}
+
+void CoderHighlighterWorker::run()
+{
+    const int n = _lines.size();
+    int i = 0;
+    int state = _state;
+    while ((i < n) && !_cancelled.load())
+    {
+        int pf = _priorityFirst.fetchAndStoreRelaxed(-1);
+        int pl = _priorityLast.load();
+        if (pf >= 0)
+        {
+            pf = qMax(pf - _first, i);
+            pl = qMin(pl - _first, n - 1);
+            if ((pf > i) && (pf <= pl) && acquire())
+            {
+                // States above the viewport are not known yet, so start from none
+                int guess = 0;
+                emit chunkReady(tokenize(pf, pl + 1, guess, true));
+            }
+        }
+        const int end = qMin(i + HIGHLIGHTER_CHUNK_BLOCKS, n);
+        if (!acquire())
+        {
+            break;
+        }
+        emit chunkReady(tokenize(i, end, state, false));
+        i = end;
+    }
+    emit finished(_generation);
+}
+
+CoderHighlighterChunk CoderHighlighterWorker::tokenize(const int from, const int to, int &state, const bool guessed) const
+{
+    CoderHighlighterChunk c;
+    c.first = _first + from;
+    c.generation = _generation;
+    c.guessed = guessed;
+    c.previous = state;
+    c.revisions = _revisions.mid(from, to - from);
+    c.states.reserve(to - from);
+    if (_tokens)
+    {
+        c.tokens.resize(to - from);
+    }
+    CoderTokenList scratch;
+    for (int i = from; i < to; i++)
+    {
+        if (!_tokens)
+        {
+            scratch.resize(0);
+        }
+        state = _tokenizer->tokenize(_lines.at(i), state, _tokens ? c.tokens[i - from] : scratch);
+        c.states << state;
+    }
+    return c;
+}
+
+APP_NAMESPACE_END
@@ -0,0 +1,529 @@
+#include "include/codertokenizer.h"
+
+APP_NAMESPACE_START
+
+QMap<const CoderHighlighterDefinition *, CoderTokenizer *> CoderTokenizer::_cache;
+
+static inline CoderToken token(const int start, const int length, const int entry)
+{
+    CoderToken t;
+    t.start = start;
+    t.length = length;
+    t.entry = entry;
+    return t;
+}
+
+static inline int bit(const QChar c)
+{
+    return (c.unicode() < 128) ? int(c.unicode()) : 128;
+}
+
+static int classEnd(const QString &p, int i)
+{
+    i++;
+    if ((i < p.size()) && (p.at(i) == '^'))
+    {
+        i++;
+    }
+    if ((i < p.size()) && (p.at(i) == ']'))
+    {
+        i++;
+    }
+    for (; i < p.size(); i++)
+    {
+        if (p.at(i) == '\\')
+        {
+            i++;
+        }
+        else if (p.at(i) == ']')
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int groupEnd(const QString &p, int i)
+{
+    int depth = 0;
+    for (; i < p.size(); i++)
+    {
+        const QChar c = p.at(i);
+        if (c == '\\')
+        {
+            i++;
+        }
+        else if (c == '[')
+        {
+            if ((i = classEnd(p, i)) < 0)
+            {
+                return -1;
+            }
+        }
+        else if (c == '(')
+        {
+            depth++;
+        }
+        else if ((c == ')') && (--depth == 0))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Characters an escape like \d or \. can match, false for the ones
+ * not worth telling apart.
+ */
+static bool escapeChars(const QChar e, QBitArray &s)
+{
+    const QChar lower = e.toLower();
+    QBitArray own(129);
+    if (lower == 'd')
+    {
+        own.fill(true, '0', '9' + 1);
+    }
+    else if (lower == 'w')
+    {
+        own.fill(true, '0', '9' + 1);
+        own.fill(true, 'A', 'Z' + 1);
+        own.fill(true, 'a', 'z' + 1);
+        own.setBit('_');
+    }
+    else if (lower == 's')
+    {
+        own.fill(true, '\t', '\r' + 1);
+        own.setBit(' ');
+    }
+    else if (e == 'n')
+    {
+        s.setBit('\n');
+        return true;
+    }
+    else if (e == 't')
+    {
+        s.setBit('\t');
+        return true;
+    }
+    else if (e.isLetterOrNumber())
+    {
+        return false;
+    }
+    else
+    {
+        s.setBit(bit(e));
+        return true;
+    }
+    if (e.isUpper())
+    {
+        own = ~own;
+    }
+    own.setBit(128);
+    s |= own;
+    return true;
+}
+
+static bool classChars(const QString &p, int i, const int end, QBitArray &s)
+{
+    const bool negate = p.at(++i) == '^';
+    if (negate)
+    {
+        i++;
+    }
+    int previous = -1;
+    for (; i < end; i++)
+    {
+        QChar c = p.at(i);
+        if ((c == '[') && ((i + 1) < end) && (p.at(i + 1) == ':'))
+        {
+            return false;
+        }
+        if (c == '\\')
+        {
+            c = p.at(++i);
+            if (c.isLetterOrNumber() && (c != 'n') && (c != 't'))
+            {
+                if (!escapeChars(c, s))
+                {
+                    return false;
+                }
+                previous = -1;
+                continue;
+            }
+            c = (c == 'n') ? QChar('\n') : ((c == 't') ? QChar('\t') : c);
+        }
+        else if ((c == '-') && (previous >= 0) && ((i + 1) < end) && (p.at(i + 1) != '\\'))
+        {
+            const int last = p.at(++i).unicode();
+            if (previous < qMin(last, 128))
+            {
+                s.fill(true, previous, qMin(last, 127) + 1);
+            }
+            if (last >= 128)
+            {
+                s.setBit(128);
+            }
+            previous = -1;
+            continue;
+        }
+        s.setBit(bit(c));
+        previous = c.unicode();
+    }
+    if (negate)
+    {
+        s = ~s;
+        s.setBit(128);
+    }
+    return true;
+}
+
+static bool firstChars(const QString &p, const int begin, const int end, QBitArray &s);
+
+/**
+ * @brief Adds what the first consuming item of a sequence can start with,
+ * walking past assertions and items that may be skipped. False when that is
+ * not plain from the pattern, or the sequence can match nothing at all.
+ */
+static bool sequenceChars(const QString &p, int i, const int end, QBitArray &s)
+{
+    while (i < end)
+    {
+        const QChar c = p.at(i);
+        QBitArray item(129);
+        int next;
+        if ((c == '^') || (c == '$'))
+        {
+            i++;
+            continue;
+        }
+        if (c == '\\')
+        {
+            if ((i + 1) >= end)
+            {
+                return false;
+            }
+            const QChar e = p.at(i + 1);
+            if (QString("bBAzZG").contains(e))
+            {
+                i += 2;
+                continue;
+            }
+            if (!escapeChars(e, item))
+            {
+                return false;
+            }
+            next = i + 2;
+        }
+        else if (c == '[')
+        {
+            const int close = classEnd(p, i);
+            if ((close < 0) || (close >= end) || !classChars(p, i, close, item))
+            {
+                return false;
+            }
+            next = close + 1;
+        }
+        else if (c == '(')
+        {
+            const int close = groupEnd(p, i);
+            if ((close < 0) || (close >= end))
+            {
+                return false;
+            }
+            const QString head = p.mid(i, 4);
+            if (head.startsWith("(?=") || head.startsWith("(?!") || head.startsWith("(?<=") || head.startsWith("(?<!"))
+            {
+                i = close + 1;
+                continue;
+            }
+            int inner = i + 1;
+            if (p.at(inner) == '?')
+            {
+                if (p.at(inner + 1) != ':')
+                {
+                    return false;
+                }
+                inner += 2;
+            }
+            if (!firstChars(p, inner, close, item))
+            {
+                return false;
+            }
+            next = close + 1;
+        }
+        else if (QString(".|)*+?{").contains(c))
+        {
+            return false;
+        }
+        else
+        {
+            item.setBit(bit(c));
+            next = i + 1;
+        }
+        s |= item;
+        const QChar q = (next < end) ? p.at(next) : QChar();
+        const QChar a = ((next + 1) < end) ? p.at(next + 1) : QChar();
+        if ((q != '?') && (q != '*') && ((q != '{') || ((a != '0') && (a != ','))))
+        {
+            return true;
+        }
+        i = next + 1;
+        if (q == '{')
+        {
+            while ((i < end) && (p.at(i - 1) != '}'))
+            {
+                i++;
+            }
+        }
+        if ((i < end) && ((p.at(i) == '?') || (p.at(i) == '+')))
+        {
+            i++;
+        }
+    }
+    return false;
+}
+
+static bool firstChars(const QString &p, const int begin, const int end, QBitArray &s)
+{
+    int depth = 0;
+    int from = begin;
+    for (int i = begin; i < end; i++)
+    {
+        const QChar c = p.at(i);
+        if (c == '\\')
+        {
+            i++;
+        }
+        else if (c == '[')
+        {
+            if ((i = classEnd(p, i)) < 0)
+            {
+                return false;
+            }
+        }
+        else if (c == '(')
+        {
+            depth++;
+        }
+        else if (c == ')')
+        {
+            depth--;
+        }
+        else if ((c == '|') && (depth == 0))
+        {
+            if (!sequenceChars(p, from, i, s))
+            {
+                return false;
+            }
+            from = i + 1;
+        }
+    }
+    return sequenceChars(p, from, end, s);
+}
+
+CoderTokenizer::CoderTokenizer(const CoderHighlighterDefinition *d)
+    : _definition(d)
+{
+    const CoderHighlighterDefinitionEntryList &entries = d->entries();
+    // Numbered back-references would point at the wrong group once merged
+    QRegularExpression backrefs("\\\\(\\d|g|k)");
+    QStringList patterns;
+    bool mergeable = true;
+    int group = 1;
+    for (int i = entries.size() - 1; i >= 0; i--)
+    {
+        const CoderHighlighterDefinitionEntry &e = entries.at(i);
+        const QRegularExpression &r = e.multiline ? e.begin : e.pattern;
+        if (e.regex.isEmpty() || r.pattern().isEmpty() || !r.isValid())
+        {
+            continue;
+        }
+        if (backrefs.match(r.pattern()).hasMatch())
+        {
+            mergeable = false;
+        }
+        Alternative a;
+        a.entry = i;
+        a.first = QBitArray(129);
+        if (!firstChars(r.pattern(), 0, r.pattern().size(), a.first))
+        {
+            a.first.fill(true);
+        }
+        a.group = group;
+        _alternatives << a;
+        patterns << QString("(%1)").arg(r.pattern());
+        group += 1 + r.captureCount();
+    }
+    // Lower priority alternatives worth trying again once one has matched
+    for (int k = 0; k < _alternatives.size(); k++)
+    {
+        for (int j = k + 1; j < _alternatives.size(); j++)
+        {
+            if ((_alternatives.at(k).first & _alternatives.at(j).first).count(true))
+            {
+                _alternatives[k].overlaps << j;
+            }
+        }
+    }
+    if (mergeable && !patterns.isEmpty())
+    {
+        _combined.setPattern(patterns.join('|'));
+        if (_combined.isValid())
+        {
+            _combined.optimize();
+        }
+        else
+        {
+            _combined.setPattern(QString());
+        }
+    }
+}
+
+const CoderTokenizer *CoderTokenizer::get(const QString &d, const QString &t)
+{
+    const CoderHighlighterDefinition *hd = CoderHighlighterDefinition::get(d, t);
+    CoderTokenizer *ct = _cache.value(hd, NULL);
+    if (!ct)
+    {
+        _cache.insert(hd, ct = new CoderTokenizer(hd));
+    }
+    return ct;
+}
+
+int CoderTokenizer::tokenize(const QString &t, const int s, CoderTokenList &tokens) const
+{
+    if (_combined.pattern().isEmpty())
+    {
+        return tokenizeEach(t, s, tokens);
+    }
+    const CoderHighlighterDefinitionEntryList &entries = _definition->entries();
+    const int length = t.length();
+    int i = 0;
+    if ((s > 0) && (s <= entries.size()))
+    {
+        QRegularExpressionMatch m = entries.at(s - 1).end.match(t);
+        if (!m.hasMatch())
+        {
+            tokens << token(0, length, s - 1);
+            return s;
+        }
+        i = m.capturedEnd();
+        tokens << token(0, i, s - 1);
+    }
+    const int n = _alternatives.size();
+    while (i < length)
+    {
+        QRegularExpressionMatch m = _combined.match(t, i);
+        if (!m.hasMatch())
+        {
+            break;
+        }
+        int k = 0;
+        while ((k < n) && (m.capturedStart(_alternatives.at(k).group) < 0))
+        {
+            k++;
+        }
+        if (k == n)
+        {
+            break;
+        }
+        const int start = m.capturedStart();
+        int end = m.capturedEnd();
+        int winner = _alternatives.at(k).entry;
+        // Alternatives ahead of the winner already failed here, only lower priority ones starting alike may be longer
+        const int first = (start < length) ? bit(t.at(start)) : -1;
+        foreach (const int j, _alternatives.at(k).overlaps)
+        {
+            if ((first < 0) || !_alternatives.at(j).first.testBit(first))
+            {
+                continue;
+            }
+            const CoderHighlighterDefinitionEntry &e = entries.at(_alternatives.at(j).entry);
+            QRegularExpressionMatch p = (e.multiline ? e.begin : e.pattern)
+                    .match(t, start, QRegularExpression::NormalMatch, QRegularExpression::AnchoredMatchOption);
+            if (p.hasMatch() && (p.capturedEnd() > end))
+            {
+                end = p.capturedEnd();
+                winner = _alternatives.at(j).entry;
+            }
+        }
+        const CoderHighlighterDefinitionEntry &e = entries.at(winner);
+        if (e.multiline)
+        {
+            QRegularExpressionMatch em = e.end.match(t, start);
+            if (!em.hasMatch())
+            {
+                tokens << token(start, length - start, winner);
+                return winner + 1;
+            }
+            end = em.capturedEnd();
+        }
+        if (end > start)
+        {
+            tokens << token(start, end - start, winner);
+            i = end;
+        }
+        else
+        {
+            i = start + 1;
+        }
+    }
+    return 0;
+}
+
+int CoderTokenizer::tokenizeEach(const QString &t, const int s, CoderTokenList &tokens) const
+{
+    const CoderHighlighterDefinitionEntryList &entries = _definition->entries();
+    int state = 0;
+    for (int i = 0; i < entries.size(); i++)
+    {
+        const CoderHighlighterDefinitionEntry &e = entries.at(i);
+        if (e.regex.isEmpty())
+        {
+            continue;
+        }
+        if (e.multiline)
+        {
+            int b = 0;
+            if (s != (i + 1))
+            {
+                b = e.begin.match(t).capturedStart();
+            }
+            while (b >= 0)
+            {
+                QRegularExpressionMatch m = e.end.match(t, b);
+                int l;
+                if (!m.hasMatch())
+                {
+                    state = i + 1;
+                    l = (t.length() - b);
+                }
+                else
+                {
+                    l = (m.capturedEnd() - b);
+                }
+                tokens << token(b, l, i);
+                if (l == 0)
+                {
+                    break;
+                }
+                b = e.begin.match(t, (b + l)).capturedStart();
+            }
+        }
+        else
+        {
+            QRegularExpressionMatch m = e.pattern.match(t);
+            while (m.hasMatch())
+            {
+                int b = m.capturedStart();
+                int l = m.capturedLength();
+                tokens << token(b, l, i);
+                m = e.pattern.match(t, b + qMax(l, 1));
+            }
+        }
+    }
+    return state;
+}
+
+APP_NAMESPACE_END
@@ -1,4 +1,6 @@
 #include <QLayout>
+#include <QScrollBar>
+#include <QTextBlock>
 #include "include/adb.h"
 #include "include/apktool.h"
 #include "include/consoledock.h"
@@ -11,7 +13,7 @@ APP_NAMESPACE_START
 ConsoleDock::ConsoleDock(QWidget *parent)
     : QDockWidget(__("console", "docks"), parent)
 {
-    _edit = new QTextEdit(this);
+    _edit = new QPlainTextEdit(this);
     QFont font;
     font.setFamily("Courier New");
     font.setFixedPitch(true);
@@ -23,45 +25,68 @@ ConsoleDock::ConsoleDock(QWidget *parent)
     palette.setColor(QPalette::Inactive, QPalette::Base, QColor("#000000"));
     _edit->setFont(font);
     _edit->setFrameStyle(QFrame::NoFrame);
+    _edit->setMaximumBlockCount(CONSOLE_MAX_LINES);
     _edit->setPalette(palette);
     _edit->setReadOnly(true);
     _edit->setTabStopWidth(4 * metrics.width('8'));
+    _edit->setUndoRedoEnabled(false);
     _edit->setWordWrapMode(QTextOption::NoWrap);
+    _formats[KindCode].setForeground(QColor(COLOR_CODE));
+    _formats[KindCommand].setForeground(QColor(COLOR_COMMAND));
+    _formats[KindError].setForeground(QColor(COLOR_ERROR));
+    _formats[KindOutput].setForeground(QColor(COLOR_OUTPUT));
+    _timer.setInterval(CONSOLE_FRAME);
+    _timer.setSingleShot(true);
+    _connections << connect(&_timer, &QTimer::timeout, this, &ConsoleDock::onFrame);
     setContentsMargins(2, 2, 2, 2);
     setObjectName("ConsoleDock");
     setWidget(_edit);
     _connections << connect(Adb::get(), &Process::executed, this, &ConsoleDock::onExecuted);
     _connections << connect(Adb::get(), &Process::executing, this, &ConsoleDock::onExecuting);
+    _connections << connect(Adb::get(), &Process::outputReady, this, &ConsoleDock::onOutputReady);
     _connections << connect(ApkTool::get(), &Process::executed, this, &ConsoleDock::onExecuted);
     _connections << connect(ApkTool::get(), &Process::executing, this, &ConsoleDock::onExecuting);
+    _connections << connect(ApkTool::get(), &Process::outputReady, this, &ConsoleDock::onOutputReady);
     _connections << connect(UberApkSigner::get(), &Process::executed, this, &ConsoleDock::onExecuted);
     _connections << connect(UberApkSigner::get(), &Process::executing, this, &ConsoleDock::onExecuting);
+    _connections << connect(UberApkSigner::get(), &Process::outputReady, this, &ConsoleDock::onOutputReady);
     _connections << connect(Java::get(), &Process::executed, this, &ConsoleDock::onExecuted);
     _connections << connect(Java::get(), &Process::executing, this, &ConsoleDock::onExecuting);
+    _connections << connect(Java::get(), &Process::outputReady, this, &ConsoleDock::onOutputReady);
+}
 
+void ConsoleDock::append(const LineKind k, const QString &t)
+{
+    _pending << Line{k, t};
+    if (_pending.size() > (2 * CONSOLE_MAX_LINES))
+    {
+        // Would scroll out of the view anyway; trimmed in bulk to keep appends cheap
+        _pending.remove(0, _pending.size() - CONSOLE_MAX_LINES);
+    }
+    if (!_timer.isActive())
+    {
+        _timer.start();
+    }
 }
 
-void ConsoleDock::onExecuted(const Process::Result &r)
+void ConsoleDock::drain(Process *p)
 {
-    if (!r.error.isEmpty())
+    _ready.remove(p);
+    foreach (const Process::Line &l, p->take())
     {
-        _edit->setTextColor(QColor(COLOR_ERROR));
-        foreach (const QString &l, r.error)
-        {
-            _edit->append(l);
-        }
+        append(l.error ? KindError : KindOutput, l.text);
     }
-    if (!r.output.isEmpty())
+}
+
+void ConsoleDock::onExecuted(const Process::Result &r)
+{
+    Process *p = qobject_cast<Process *>(sender());
+    if (p)
     {
-        _edit->setTextColor(QColor(COLOR_OUTPUT));
-        foreach (const QString &l, r.output)
-        {
-            _edit->append(l);
-        }
+        drain(p);
     }
-    _edit->setTextColor(QColor(COLOR_CODE));
-    _edit->append(__("exit_code", "console", QString::number(r.code)));
-    _edit->append(QString());
+    append(KindCode, __("exit_code", "console", QString::number(r.code)));
+    append(KindCode, QString());
 }
 
 void ConsoleDock::onExecuting(const QString &c, const QStringList &a)
@@ -77,8 +102,60 @@ void ConsoleDock::onExecuting(const QString &c, const QStringList &a)
         }
         line.append(' ' + arg);
     }
-    _edit->setTextColor(QColor(COLOR_COMMAND));
-    _edit->append(line.trimmed());
+    Process *p = qobject_cast<Process *>(sender());
+    if (p)
+    {
+        drain(p);
+    }
+    append(KindCommand, line.trimmed());
+}
+
+void ConsoleDock::onFrame()
+{
+    // Lines are only taken from the tools here, so a busy view slows them down rather than piling up
+    foreach (Process *p, _ready)
+    {
+        drain(p);
+    }
+    if (_pending.isEmpty())
+    {
+        return;
+    }
+    QScrollBar *bar = _edit->verticalScrollBar();
+    const bool bottom = bar->value() == bar->maximum();
+    QTextCursor cursor(_edit->document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.beginEditBlock();
+    bool first = _edit->document()->isEmpty();
+    for (int i = qMax(0, _pending.size() - CONSOLE_MAX_LINES); i < _pending.size(); i++)
+    {
+        const Line &l = _pending.at(i);
+        if (!first)
+        {
+            cursor.insertBlock();
+        }
+        first = false;
+        cursor.insertText(l.text, _formats[l.kind]);
+    }
+    cursor.endEditBlock();
+    _pending.clear();
+    if (bottom)
+    {
+        bar->setValue(bar->maximum());
+    }
+}
+
+void ConsoleDock::onOutputReady()
+{
+    Process *p = qobject_cast<Process *>(sender());
+    if (p)
+    {
+        _ready.insert(p);
+        if (!_timer.isActive())
+        {
+            _timer.start();
+        }
+    }
 }
 
 ConsoleDock::~ConsoleDock()
@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <QFile>
+#include <QTextStream>
+#include "include/decodebatch.h"
+#include "include/decoderunnable.h"
+#include "include/preferences.h"
+#include "include/runner.h"
+
+APP_NAMESPACE_START
+
+DecodeBatch::DecodeBatch(const QString &r, QObject *p)
+    : QObject(p), _heap(Preferences::get()->javaHeap()), _parallel(Preferences::get()->parallelJobs()), _pending(0), _report(r), _started(QDateTime::currentDateTime())
+{
+    _timer.start();
+    _connections << connect(Runner::get(), &Runner::jobChanged, this, &DecodeBatch::onJobChanged);
+}
+
+void DecodeBatch::add(const QString &a, const QString &p, const QString &f, const bool s, const bool r)
+{
+    _ids.insert(Runner::get()->add(new DecodeRunnable(a, p, f, s, r)), _entries.size());
+    _entries << Entry{a, 0, p, Runnable::StateQueued};
+    _pending++;
+}
+
+void DecodeBatch::onJobChanged(const int id, const int s)
+{
+    if (!_ids.contains(id) || (s == Runnable::StateQueued) || (s == Runnable::StateRunning))
+    {
+        return;
+    }
+    Entry &e = _entries[_ids.take(id)];
+    e.elapsed = Runner::get()->elapsed(id);
+    e.state = s;
+    if (--_pending == 0)
+    {
+        int succeeded = 0;
+        foreach (const Entry &i, _entries)
+        {
+            if (i.state == Runnable::StateSucceeded)
+            {
+                succeeded++;
+            }
+        }
+        write();
+        emit finished(_report, succeeded, _entries.size());
+        deleteLater();
+    }
+}
+
+/**
+ * @brief Plain text, failures first and then every APK slowest first, so the
+ * outliers of a large batch are at the top.
+ */
+bool DecodeBatch::write()
+{
+    QFile file(_report);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
+    {
+        return false;
+    }
+    QVector<Entry> entries = _entries;
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return a.elapsed > b.elapsed; });
+    auto seconds = [](const qint64 ms) { return QString::number(ms / 1000.0, 'f', 1); };
+    int counts[Runnable::StateCancelled + 1] = {0};
+    qint64 total = 0;
+    foreach (const Entry &e, entries)
+    {
+        counts[e.state]++;
+        total += e.elapsed;
+    }
+    QTextStream out(&file);
+    out << "Batch decode, started " << _started.toString(Qt::ISODate) << endl;
+    out << "APKs: " << entries.size() << ", succeeded: " << counts[Runnable::StateSucceeded]
+        << ", failed: " << counts[Runnable::StateFailed] << ", cancelled: " << counts[Runnable::StateCancelled] << endl;
+    out << "Parallel jobs: " << _parallel << ", Java heap: " << _heap << " MB" << endl;
+    out << "Wall time: " << seconds(_timer.elapsed()) << " s, job time: " << seconds(total) << " s" << endl;
+    if (counts[Runnable::StateFailed] > 0)
+    {
+        out << endl << "Failed:" << endl;
+        foreach (const Entry &e, entries)
+        {
+            if (e.state == Runnable::StateFailed)
+            {
+                out << "  " << e.apk << endl;
+            }
+        }
+    }
+    out << endl << "Timings:" << endl;
+    foreach (const Entry &e, entries)
+    {
+        const char *state = (e.state == Runnable::StateSucceeded) ? "ok" : ((e.state == Runnable::StateFailed) ? "failed" : "cancelled");
+        out << "  " << seconds(e.elapsed).rightJustified(8) << " s  " << QString(state).leftJustified(9) << "  " << e.apk << " -> " << e.project << endl;
+    }
+    return true;
+}
+
+DecodeBatch::~DecodeBatch()
+{
+    APP_CONNECTIONS_DISCONNECT
+}
+
+APP_NAMESPACE_END
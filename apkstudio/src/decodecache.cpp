@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <QAtomicInt>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThreadPool>
+#include <QVector>
+#include "include/apktool.h"
+#include "include/constants.h"
+#include "include/decodecache.h"
+#include "include/fileutils.h"
+#include "include/pathutils.h"
+#include "include/preferences.h"
+
+APP_NAMESPACE_START
+
+static QMutex entries;
+
+// Entries being copied out right now, which trimming has to leave alone
+static QHash<QString, int> restoring;
+
+/**
+ * @brief Hashes chunks of a mapped file; helpers and the caller take chunks
+ * from the same counter, so a busy pool only means less help.
+ */
+struct ChunkHasher : public QRunnable
+{
+    const uchar *data;
+    QSemaphore *done;
+    QVector<QByteArray> *hashes;
+    QAtomicInt *next;
+    qint64 size;
+
+    void run()
+    {
+        hash(data, size, next, hashes);
+        done->release();
+    }
+
+    static void hash(const uchar *data, const qint64 size, QAtomicInt *next, QVector<QByteArray> *hashes)
+    {
+        int i;
+        while ((i = next->fetchAndAddOrdered(1)) < hashes->size())
+        {
+            const qint64 offset = qint64(i) * DECODE_CACHE_CHUNK;
+            const qint64 length = qMin<qint64>(DECODE_CACHE_CHUNK, size - offset);
+            (*hashes)[i] = QCryptographicHash::hash(QByteArray::fromRawData(reinterpret_cast<const char *>(data + offset), int(length)), QCryptographicHash::Sha1);
+        }
+    }
+};
+
+/**
+ * @brief Empty when the APK cannot be read, which disables the cache for it.
+ * The apktool jar stands in for its version by path, size and time, so no JVM
+ * is started just to ask.
+ */
+QString DecodeCache::key(const QString &a, const QString &f, const bool s, const bool r)
+{
+    QFile file(a);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return QString();
+    }
+    const qint64 size = file.size();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const uchar *data = size ? file.map(0, size) : 0;
+    if (data)
+    {
+        QVector<QByteArray> hashes(int((size + DECODE_CACHE_CHUNK - 1) / DECODE_CACHE_CHUNK));
+        QAtomicInt next(0);
+        QSemaphore done;
+        const int helpers = qMin(hashes.size() - 1, QThreadPool::globalInstance()->maxThreadCount());
+        for (int i = 0; i < helpers; i++)
+        {
+            ChunkHasher *h = new ChunkHasher;
+            h->data = data;
+            h->done = &done;
+            h->hashes = &hashes;
+            h->next = &next;
+            h->size = size;
+            QThreadPool::globalInstance()->start(h);
+        }
+        ChunkHasher::hash(data, size, &next, &hashes);
+        done.acquire(helpers);
+        foreach (const QByteArray &h, hashes)
+        {
+            hash.addData(h);
+        }
+    }
+    else if (!hash.addData(&file))
+    {
+        return QString();
+    }
+    const QFileInfo jar(ApkTool::get()->path());
+    const QString flags = QString("%1|%2|%3|%4|%5|%6")
+            .arg(size)
+            .arg(jar.fileName())
+            .arg(jar.size())
+            .arg(jar.lastModified().toMSecsSinceEpoch())
+            .arg(s ? "sources" : "no-sources")
+            .arg(r ? "resources" : "no-resources");
+    hash.addData(flags.toUtf8());
+    hash.addData(f.toUtf8());
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QString DecodeCache::path(const QString &k)
+{
+    return PathUtils::combine(PathUtils::combine(Preferences::get()->appPath(), FOLDER_DECODED), k);
+}
+
+/**
+ * @brief Replaces the project with the cached decode, as apktool -f would.
+ */
+bool DecodeCache::restore(const QString &k, const QString &p)
+{
+    const QString entry = path(k);
+    {
+        QMutexLocker locker(&entries);
+        if (!QFile::exists(PathUtils::combine(entry, "project/apktool.yml")))
+        {
+            return false;
+        }
+        QFile used(PathUtils::combine(entry, "used"));
+        if (used.open(QIODevice::WriteOnly))
+        {
+            used.write(QByteArray::number(QDateTime::currentMSecsSinceEpoch()));
+            used.close();
+        }
+        restoring[k]++;
+    }
+    // Copied without the lock, without reflinks this is a full copy and batch decodes would queue on it
+    const bool restored = FileUtils::rimraf(p) && FileUtils::clone(PathUtils::combine(entry, "project"), p);
+    if (!restored)
+    {
+        FileUtils::rimraf(p);
+    }
+    QMutexLocker locker(&entries);
+    if (--restoring[k] == 0)
+    {
+        restoring.remove(k);
+    }
+    return restored;
+}
+
+/**
+ * @brief Copies a fresh decode in under a temporary name, so a half written
+ * entry is never found.
+ */
+void DecodeCache::store(const QString &k, const QString &p)
+{
+    const QString entry = path(k);
+    const QString temp = entry + ".tmp" + QString::number(QDateTime::currentMSecsSinceEpoch());
+    if (QFile::exists(entry) || !FileUtils::clone(p, PathUtils::combine(temp, "project")))
+    {
+        FileUtils::rimraf(temp);
+        return;
+    }
+    QFile used(PathUtils::combine(temp, "used"));
+    if (used.open(QIODevice::WriteOnly))
+    {
+        used.write(QByteArray::number(QDateTime::currentMSecsSinceEpoch()));
+        used.close();
+    }
+    QMutexLocker locker(&entries);
+    if (!QDir().rename(temp, entry))
+    {
+        FileUtils::rimraf(temp);
+    }
+    trim();
+}
+
+void DecodeCache::trim()
+{
+    QDir root(PathUtils::combine(Preferences::get()->appPath(), FOLDER_DECODED));
+    QFileInfoList dirs = root.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+    if (dirs.size() <= DECODE_CACHE_MAX_ENTRIES)
+    {
+        return;
+    }
+    QVector<QPair<qint64, QString> > used;
+    foreach (const QFileInfo &d, dirs)
+    {
+        if (!d.fileName().contains('.') && !restoring.contains(d.fileName()))
+        {
+            used << qMakePair(QFileInfo(QDir(d.filePath()).filePath("used")).lastModified().toMSecsSinceEpoch(), d.filePath());
+        }
+    }
+    std::sort(used.begin(), used.end());
+    for (int i = 0; i < (used.size() - DECODE_CACHE_MAX_ENTRIES); i++)
+    {
+        FileUtils::rimraf(used.at(i).second);
+    }
+}
+
+APP_NAMESPACE_END
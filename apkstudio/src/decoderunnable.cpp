@@ -1,28 +1,64 @@
+#include <QFile>
+#include <QFileInfo>
 #include "include/apktool.h"
+#include "include/constants.h"
+#include "include/decodecache.h"
 #include "include/decoderunnable.h"
+#include "include/pathutils.h"
+#include "include/qrc.h"
 
 APP_NAMESPACE_START
 
 DecodeRunnable::DecodeRunnable(const QString &a, const QString &p, const QString &f, const bool s, const bool r, QObject *o)
-    : Runnable(o), _apk(a), _framework(f), _project(p), _resources(r), _sources(s)
+    : Runnable(__("decode", "jobs", QFileInfo(a).fileName()), RUNNER_RESOURCE_JAVA, o), _apk(a), _framework(f), _project(p), _resources(r), _sources(s)
 {
-    _connections << connect(this, SIGNAL(decodeFailure(QString)), o, SLOT(onDecodeFailure(QString)), Qt::QueuedConnection);
-    _connections << connect(this, SIGNAL(decodeSuccess(QString)), o, SLOT(onDecodeSuccess(QString)), Qt::QueuedConnection);
+    if (o)
+    {
+        // Batch decodes have no receiver, they are followed through the Runner instead
+        _connections << connect(this, SIGNAL(decodeFailure(QString)), o, SLOT(onDecodeFailure(QString)), Qt::QueuedConnection);
+        _connections << connect(this, SIGNAL(decodeSuccess(QString)), o, SLOT(onDecodeSuccess(QString)), Qt::QueuedConnection);
+    }
 }
 
-void DecodeRunnable::run()
+/**
+ * @brief An APK decoded before with the same apktool and options is restored
+ * from the cache instead of decoded again.
+ */
+bool DecodeRunnable::execute()
 {
-    emit runnableStarted();
+    const QString key = DecodeCache::key(_apk, _framework, _sources, _resources);
+    if (!key.isEmpty() && !isCancelled() && DecodeCache::restore(key, _project))
+    {
+        source();
+        emit decodeSuccess(_project);
+        return true;
+    }
     Process::Result r = ApkTool::get()->decode(_apk, _project, _framework, _sources, _resources);
     if (r.code == 0)
     {
+        if (!key.isEmpty() && !isCancelled())
+        {
+            DecodeCache::store(key, _project);
+        }
+        source();
         emit decodeSuccess(_project);
+        return true;
     }
-    else
+    emit decodeFailure(_apk);
+    return false;
+}
+
+/**
+ * @brief Remembers which APK the project came from, so resource ids can be
+ * looked up in its table.
+ */
+void DecodeRunnable::source()
+{
+    QFile file(PathUtils::combine(_project, FILE_APK_SOURCE));
+    if (file.open(QIODevice::WriteOnly))
     {
-        emit decodeFailure(_apk);
+        file.write(QFileInfo(_apk).absoluteFilePath().toUtf8());
     }
-    emit runnableStopped();
 }
 
 APP_NAMESPACE_END
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <cstring>
+#include <QByteArray>
+#include <QHash>
+#include <QtEndian>
+#include "include/dexreader.h"
+
+APP_NAMESPACE_START
+
+static inline quint16 u16(const uchar *p)
+{
+    return qFromLittleEndian<quint16>(p);
+}
+
+static inline quint32 u32(const uchar *p)
+{
+    return qFromLittleEndian<quint32>(p);
+}
+
+static bool uleb128(const uchar *&p, const uchar *end, quint32 *value)
+{
+    quint32 v = 0;
+    for (int shift = 0; (shift < 35) && (p < end); shift += 7)
+    {
+        const uchar b = *p++;
+        v |= quint32(b & 0x7f) << shift;
+        if (!(b & 0x80))
+        {
+            *value = v;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Packages are keyed by the raw bytes of the descriptor, e.g. "com/foo"
+ * out of "Lcom/foo/Bar;", and turned into names once at the end.
+ */
+bool DexReader::read(const uchar *d, const qint64 size, Summary *s)
+{
+    if (!d || (size < 0x70) || (memcmp(d, "dex\n", 4) != 0) || d[7] || (u32(d + 0x28) != 0x12345678))
+    {
+        return false;
+    }
+    const uchar *end = d + size;
+    s->version = QByteArray(reinterpret_cast<const char *>(d + 4), 3).toInt();
+    s->strings = int(u32(d + 0x38));
+    s->fieldRefs = int(u32(d + 0x50));
+    s->methodRefs = int(u32(d + 0x58));
+    s->classes = 0;
+    s->methods = 0;
+    s->packages.clear();
+    const quint32 strings = u32(d + 0x38);
+    const quint32 stringsOffset = u32(d + 0x3c);
+    const quint32 types = u32(d + 0x40);
+    const quint32 typesOffset = u32(d + 0x44);
+    const quint32 classes = u32(d + 0x60);
+    const quint32 classesOffset = u32(d + 0x64);
+    if (((quint64(stringsOffset) + (quint64(strings) * 4)) > quint64(size))
+            || ((quint64(typesOffset) + (quint64(types) * 4)) > quint64(size))
+            || ((quint64(classesOffset) + (quint64(classes) * 32)) > quint64(size)))
+    {
+        return false;
+    }
+    QHash<QByteArray, int> index;
+    QVector<QPair<QByteArray, Package> > packages;
+    for (quint32 c = 0; c < classes; c++)
+    {
+        const uchar *def = d + classesOffset + (c * 32);
+        int methods = 0;
+        const quint32 data = u32(def + 24);
+        if (data && (data < quint64(size)))
+        {
+            const uchar *p = d + data;
+            quint32 counts[4];
+            if (uleb128(p, end, counts) && uleb128(p, end, counts + 1) && uleb128(p, end, counts + 2) && uleb128(p, end, counts + 3))
+            {
+                methods = int(counts[2] + counts[3]);
+            }
+        }
+        QByteArray key;
+        const quint32 type = u32(def);
+        if (type < types)
+        {
+            const quint32 string = u32(d + typesOffset + (type * 4));
+            if (string < strings)
+            {
+                const quint32 offset = u32(d + stringsOffset + (string * 4));
+                const uchar *p = d + qMin<quint64>(offset, quint64(size));
+                quint32 length;
+                if (uleb128(p, end, &length) && (p < end) && (*p == 'L'))
+                {
+                    const uchar *slash = 0;
+                    for (const uchar *q = p; (q < end) && *q && (*q != ';'); q++)
+                    {
+                        if (*q == '/')
+                        {
+                            slash = q;
+                        }
+                    }
+                    if (slash)
+                    {
+                        key = QByteArray::fromRawData(reinterpret_cast<const char *>(p + 1), int(slash - p - 1));
+                    }
+                }
+            }
+        }
+        QHash<QByteArray, int>::const_iterator it = index.constFind(key);
+        if (it == index.constEnd())
+        {
+            it = index.insert(key, packages.size());
+            packages << qMakePair(key, Package{QString(), 0, 0});
+        }
+        Package &package = packages[it.value()].second;
+        package.classes++;
+        package.methods += methods;
+        s->classes++;
+        s->methods += methods;
+    }
+    s->packages.reserve(packages.size());
+    for (int i = 0; i < packages.size(); i++)
+    {
+        Package p = packages.at(i).second;
+        p.name = QString::fromUtf8(packages.at(i).first).replace('/', '.');
+        s->packages << p;
+    }
+    std::sort(s->packages.begin(), s->packages.end(), [](const Package &a, const Package &b) {
+        return (a.methods != b.methods) ? (a.methods > b.methods) : (a.name < b.name);
+    });
+    return true;
+}
+
+APP_NAMESPACE_END
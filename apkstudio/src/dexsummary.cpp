@@ -0,0 +1,126 @@
+#include <QApplication>
+#include <QDialogButtonBox>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QRegularExpression>
+#include <QVBoxLayout>
+#include "include/constants.h"
+#include "include/dexreader.h"
+#include "include/dexsummary.h"
+#include "include/qrc.h"
+#include "include/zipreader.h"
+
+APP_NAMESPACE_START
+
+DexSummary::DexSummary(const QString &a, QWidget *p)
+    : Dialog("", p)
+{
+#ifdef Q_OS_LINUX
+    setMinimumSize(560, 400);
+#else
+    setMinimumSize(480, 360);
+#endif
+    setWindowIcon(Qrc::icon("toolbar_apk"));
+    setWindowTitle(__("dex_summary", "titles", QFileInfo(a).fileName()));
+    _tree = new QTreeWidget(this);
+    _tree->setColumnCount(4);
+    _tree->setHeaderLabels(QStringList() << __("name", "dex") << __("classes", "dex") << __("methods", "dex") << __("method_refs", "dex"));
+    _tree->setUniformRowHeights(true);
+    _tree->header()->setStretchLastSection(false);
+    _tree->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    _tree->header()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+    _tree->header()->setSectionResizeMode(2, QHeaderView::ResizeToContents);
+    _tree->header()->setSectionResizeMode(3, QHeaderView::ResizeToContents);
+    _totals = new QLabel(this);
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    QDialogButtonBox *buttons = new QDialogButtonBox(this);
+    buttons->addButton(new QPushButton(__("close", "buttons"), buttons), QDialogButtonBox::RejectRole);
+    layout->addWidget(_tree);
+    layout->addWidget(_totals);
+    layout->addWidget(buttons);
+    setLayout(layout);
+    _connections << connect(buttons, SIGNAL(rejected()), this, SLOT(close()));
+    summarise(a);
+}
+
+void DexSummary::display(const QString &a, QWidget *p)
+{
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    DexSummary dialog(a, p);
+    QApplication::restoreOverrideCursor();
+    if (dialog._tree->topLevelItemCount() == 0)
+    {
+        QMessageBox::warning(p, __("dex_summary", "titles", QFileInfo(a).fileName()), __("no_dex", "messages"));
+        return;
+    }
+    dialog.exec();
+}
+
+/**
+ * @brief Dex files are parsed in place when stored, else from one inflated
+ * copy each; nothing beyond the header and class tables is visited.
+ */
+void DexSummary::summarise(const QString &a)
+{
+    QElapsedTimer timer;
+    timer.start();
+    ZipReader reader;
+    if (!reader.open(a))
+    {
+        return;
+    }
+    const QRegularExpression regex(REGEX_DEX_ENTRY);
+    int classes = 0;
+    int files = 0;
+    int methods = 0;
+    for (int i = 0; i < reader.entryCount(); i++)
+    {
+        const QString name = reader.entry(i).name;
+        if (!regex.match(name).hasMatch())
+        {
+            continue;
+        }
+        QByteArray buffer;
+        const uchar *data = reader.data(i);
+        qint64 size = qint64(reader.entry(i).size);
+        if (!data)
+        {
+            buffer = reader.read(i);
+            data = reinterpret_cast<const uchar *>(buffer.constData());
+            size = buffer.size();
+        }
+        DexReader::Summary summary;
+        if (!DexReader::read(data, size, &summary))
+        {
+            continue;
+        }
+        // Past 65536 method references a dex cannot take more code; shown so multidex splits can be judged
+        QTreeWidgetItem *item = new QTreeWidgetItem(_tree);
+        item->setText(0, __("file", "dex", name, QString::number(summary.version)));
+        item->setText(1, QString::number(summary.classes));
+        item->setText(2, QString::number(summary.methods));
+        item->setText(3, __("references", "dex", QString::number(summary.methodRefs), QString::number((qint64(summary.methodRefs) * 100) / DEX_MAX_REFERENCES)));
+        item->setToolTip(0, __("details", "dex", QString::number(summary.strings), QString::number(summary.fieldRefs)));
+        foreach (const DexReader::Package &p, summary.packages)
+        {
+            QTreeWidgetItem *child = new QTreeWidgetItem(item);
+            child->setText(0, p.name.isEmpty() ? __("default_package", "dex") : p.name);
+            child->setText(1, QString::number(p.classes));
+            child->setText(2, QString::number(p.methods));
+        }
+        classes += summary.classes;
+        methods += summary.methods;
+        files++;
+    }
+    for (int i = 0; i < _tree->topLevelItemCount(); i++)
+    {
+        _tree->topLevelItem(i)->setExpanded(_tree->topLevelItemCount() == 1);
+    }
+    _totals->setText(__("totals", "dex", QString::number(files), QString::number(classes))
+                     .arg(methods).arg(timer.elapsed()));
+}
+
+APP_NAMESPACE_END
@@ -1,9 +1,12 @@
+#include <QDateTime>
 #include <QDesktopServices>
 #include <QFileInfo>
 #include <QInputDialog>
+#include <QRegularExpression>
 #include <QTabBar>
 #include <QTextCodec>
 #include <QTextStream>
+#include <QToolTip>
 #include "include/coder.h"
 #include "include/coderhighlighter.h"
 #include "include/constants.h"
@@ -12,7 +15,10 @@
 #include "include/findreplace.h"
 #include "include/preferences.h"
 #include "include/qrc.h"
+#include "include/resourcetable.h"
 #include "include/runner.h"
+#include "include/smaliindex.h"
+#include "include/textviewer.h"
 #include "include/viewer.h"
 
 APP_NAMESPACE_START
@@ -23,7 +29,9 @@ EditorTabs::EditorTabs(QWidget *parent)
     _connections << connect(parent, SIGNAL(editCopy()), this, SLOT(onEditCopy()));
     _connections << connect(parent, SIGNAL(editCut()), this, SLOT(onEditCut()));
     _connections << connect(parent, SIGNAL(editFind()), this, SLOT(onEditFind()));
+    _connections << connect(parent, SIGNAL(editFindUsages()), this, SLOT(onEditFindUsages()));
     _connections << connect(parent, SIGNAL(editGoto()), this, SLOT(onEditGoto()));
+    _connections << connect(parent, SIGNAL(editGotoDefinition()), this, SLOT(onEditGotoDefinition()));
     _connections << connect(parent, SIGNAL(editPaste()), this, SLOT(onEditPaste()));
     _connections << connect(parent, SIGNAL(editRedo()), this, SLOT(onEditRedo()));
     _connections << connect(parent, SIGNAL(editReplace()), this, SLOT(onEditReplace()));
@@ -31,6 +39,7 @@ EditorTabs::EditorTabs(QWidget *parent)
     _connections << connect(parent, SIGNAL(fileClose()), this, SLOT(onFileClose()));
     _connections << connect(parent, SIGNAL(fileCloseAll()), this, SLOT(onFileCloseAll()));
     _connections << connect(parent, SIGNAL(fileOpen(QString)), this, SLOT(onFileOpen(QString)));
+    _connections << connect(parent, SIGNAL(fileOpenAt(QString, int)), this, SLOT(onFileOpenAt(QString, int)));
     _connections << connect(parent, SIGNAL(fileSave()), this, SLOT(onFileSave()));
     _connections << connect(parent, SIGNAL(fileSaveAll()), this, SLOT(onFileSaveAll()));
     _connections << connect(this, &QTabWidget::tabCloseRequested, this, &EditorTabs::onTabCloseRequested);
@@ -38,10 +47,34 @@ EditorTabs::EditorTabs(QWidget *parent)
     _connections << connect(this, &EditorTabs::currentChanged, this, &EditorTabs::onCurrentChanged);
     _connections << connect(this, SIGNAL(fileChanged(QString)), parent, SLOT(onFileChanged(QString)));
     _connections << connect(this, SIGNAL(fileSaved(QString)), parent, SLOT(onFileSaved(QString)));
+    _connections << connect(this, SIGNAL(symbolRequested(QString, bool)), parent, SLOT(onSymbolRequested(QString, bool)));
     setMovable(true);
     setTabsClosable(true);
 }
 
+void EditorTabs::onCoderLoaded()
+{
+    Coder *c = qobject_cast<Coder *>(sender());
+    if (c)
+    {
+        // Attached once the text is complete, so large documents pick the lazy mode up front
+        QFileInfo fi(c->property(TAB_PROPERTY_PATH).toString());
+        CoderHighlighter *h = new CoderHighlighter(fi.suffix() + ".def", HIGHLIGHTER_THEME, c->document());
+        _connections << connect(c, &Coder::viewportChanged, h, &CoderHighlighter::setViewport);
+        if (c->viewportFirst() >= 0)
+        {
+            h->setViewport(c->viewportFirst(), c->viewportLast());
+        }
+        const QVariant l = c->property(TAB_PROPERTY_LINE);
+        if (l.isValid())
+        {
+            c->setProperty(TAB_PROPERTY_LINE, QVariant());
+            c->setTextCursor(QTextCursor(c->document()->findBlockByNumber(l.toInt())));
+            c->centerCursor();
+        }
+    }
+}
+
 void EditorTabs::onCurrentChanged(const int i)
 {
     emit fileChanged(_files.key(i, QString()));
@@ -63,10 +96,15 @@ void EditorTabs::onEditCopy()
     {
         QWidget *w = widget(i);
         Coder *c;
+        TextViewer *v;
         if (w && (c = dynamic_cast<Coder *>(w)))
         {
             c->copy();
         }
+        else if (w && (v = dynamic_cast<TextViewer *>(w)))
+        {
+            v->copy();
+        }
     }
 }
 
@@ -111,6 +149,7 @@ void EditorTabs::onEditGoto()
     {
         QWidget *w = widget(i);
         Coder *c;
+        TextViewer *v;
         if (w && (c = dynamic_cast<Coder *>(w)))
         {
             bool ok;
@@ -120,6 +159,15 @@ void EditorTabs::onEditGoto()
                 c->setTextCursor(QTextCursor(c->document()->findBlockByLineNumber(r - 1)));
             }
         }
+        else if (w && (v = dynamic_cast<TextViewer *>(w)))
+        {
+            bool ok;
+            int r = QInputDialog::getInt(this, __("goto", "titles"), __("line_no", "forms"), v->currentRow() + 1, 1, v->rowCount(), 1, &ok);
+            if (ok)
+            {
+                v->setCurrentRow(r - 1);
+            }
+        }
     }
 }
 
@@ -211,11 +259,24 @@ void EditorTabs::onFileOpen(const QString &p)
     {
         QFileInfo fi(p);
         QString ext = fi.suffix();
-        if (QString(EDITOR_EXT_CODER).contains(ext, Qt::CaseInsensitive))
+        if (QString(EDITOR_EXT_CODER).contains(ext, Qt::CaseInsensitive)
+                && (fi.size() >= (qint64(Preferences::get()->viewerThreshold()) * 1024 * 1024)))
+        {
+            TextViewer *v = new TextViewer(this);
+            if (!v->open(p, fi.suffix() + ".def"))
+            {
+                delete v;
+                return;
+            }
+            w = v;
+        }
+        else if (QString(EDITOR_EXT_CODER).contains(ext, Qt::CaseInsensitive))
         {
             Coder *c = new Coder(this);
-            c->setPlainText(FileUtils::read(p));
-            new CoderHighlighter(fi.suffix() + ".def", HIGHLIGHTER_THEME, c->document());
+            c->setProperty(TAB_PROPERTY_PATH, p);
+            _connections << connect(c, &Coder::loaded, this, &EditorTabs::onCoderLoaded);
+            _connections << connect(c, &Coder::tooltipRequested, this, &EditorTabs::onTooltipRequested);
+            c->load(FileUtils::read(p));
             w = c;
         }
         else if (QString(EDITOR_EXT_VIEWER).contains(ext, Qt::CaseInsensitive))
@@ -239,6 +300,31 @@ void EditorTabs::onFileOpen(const QString &p)
     emit fileChanged(p);
 }
 
+void EditorTabs::onFileOpenAt(const QString &p, const int l)
+{
+    onFileOpen(p);
+    QWidget *w = currentWidget();
+    Coder *c;
+    TextViewer *v;
+    if (w && (c = dynamic_cast<Coder *>(w)))
+    {
+        if (c->isReadOnly())
+        {
+            // Still loading, the line may not be there yet
+            c->setProperty(TAB_PROPERTY_LINE, l);
+        }
+        else
+        {
+            c->setTextCursor(QTextCursor(c->document()->findBlockByNumber(l)));
+            c->centerCursor();
+        }
+    }
+    else if (w && (v = dynamic_cast<TextViewer *>(w)))
+    {
+        v->setCurrentRow(l);
+    }
+}
+
 void EditorTabs::onFileSave()
 {
     int i;
@@ -252,7 +338,7 @@ void EditorTabs::onFileSave(const int i)
 {
     QWidget *w = widget(i);
     Coder *c;
-    if (w && (c = dynamic_cast<Coder *>(w)))
+    if (w && (c = dynamic_cast<Coder *>(w)) && !c->isReadOnly())
     {
         QString p = w->property(TAB_PROPERTY_PATH).toString();
         QFileInfo fi(p);
@@ -299,6 +385,105 @@ void EditorTabs::onTabMoved(const int from, const int to)
     _files.insert(t, from);
 }
 
+/**
+ * @brief Shows what a resource id under the mouse, like 0x7f0b0001 in smali
+ * or @0x7f0b0001 in extracted XML, stands for.
+ */
+void EditorTabs::onTooltipRequested(const QPoint &p)
+{
+    Coder *c = qobject_cast<Coder *>(sender());
+    if (!c)
+    {
+        return;
+    }
+    const QTextCursor cursor = c->cursorForPosition(c->viewport()->mapFrom(c, p));
+    const QString line = cursor.block().text();
+    const int column = cursor.positionInBlock();
+    QRegularExpressionMatchIterator it = QRegularExpression(REGEX_RESOURCE_ID).globalMatch(line);
+    while (it.hasNext())
+    {
+        const QRegularExpressionMatch m = it.next();
+        if ((column < m.capturedStart()) || (column > m.capturedEnd()))
+        {
+            continue;
+        }
+        const quint32 id = m.captured(1).toUInt(0, 16);
+        ResourceTable *t;
+        QString name;
+        if ((id >> 24) && (t = table(c->property(TAB_PROPERTY_PATH).toString())) && !(name = t->name(id)).isEmpty())
+        {
+            QString text = QString("<b>%1</b>").arg(name.toHtmlEscaped());
+            foreach (const QString &v, t->values(id))
+            {
+                text.append("<br/>").append(v.toHtmlEscaped());
+            }
+            QToolTip::showText(c->mapToGlobal(p), text, c);
+            return;
+        }
+        break;
+    }
+    QToolTip::hideText();
+}
+
+void EditorTabs::requestSymbol(const bool u)
+{
+    int i;
+    if ((i = currentIndex()) >= 0)
+    {
+        QWidget *w = widget(i);
+        Coder *c;
+        if (w && (c = dynamic_cast<Coder *>(w)))
+        {
+            QString owner;
+            for (QTextBlock b = c->document()->begin(); b.isValid(); b = b.next())
+            {
+                const QString line = b.text().trimmed();
+                if (line.startsWith(".class "))
+                {
+                    owner = line.section(' ', -1);
+                    break;
+                }
+                if (line.startsWith(".method "))
+                {
+                    break;
+                }
+            }
+            const QTextCursor cursor = c->textCursor();
+            const QString s = SmaliIndex::symbolAt(cursor.block().text(), cursor.positionInBlock(), owner);
+            if (!s.isEmpty())
+            {
+                emit symbolRequested(s, u);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Table for the project or APK the file comes from, opened once and
+ * again only when it has been rebuilt.
+ */
+ResourceTable *EditorTabs::table(const QString &p)
+{
+    const QString source = ResourceTable::sourceFor(p);
+    if (source.isEmpty())
+    {
+        return 0;
+    }
+    const qint64 modified = QFileInfo(source).lastModified().toMSecsSinceEpoch();
+    QHash<QString, QPair<qint64, QSharedPointer<ResourceTable> > >::const_iterator it = _tables.constFind(source);
+    if ((it != _tables.constEnd()) && (it->first == modified))
+    {
+        return it->second.data();
+    }
+    QSharedPointer<ResourceTable> t(new ResourceTable());
+    if (!t->open(source))
+    {
+        t.clear();
+    }
+    _tables.insert(source, qMakePair(modified, t));
+    return t.data();
+}
+
 EditorTabs::~EditorTabs()
 {
     Preferences::get()
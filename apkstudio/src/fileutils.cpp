@@ -1,29 +1,132 @@
+#include <climits>
 #include <QDir>
 #include <QDesktopServices>
 #include <QFile>
 #include <QProcess>
 #include <QTextCodec>
-#include <QTextStream>
 #include <QUrl>
 #include "include/fileutils.h"
 #include "include/preferences.h"
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#elif defined(Q_OS_MAC)
+#include <sys/clonefile.h>
+#endif
 
 APP_NAMESPACE_START
 
+/**
+ * @brief Copies a tree, sharing file blocks with the source where the file
+ * system can. Never hard links: editors write files in place.
+ */
+bool FileUtils::clone(const QString &f, const QString &t)
+{
+    const QFileInfo info(f);
+    if (!info.isDir())
+    {
+        return cloneFile(f, t);
+    }
+    if (!QDir().mkpath(t))
+    {
+        return false;
+    }
+    foreach (const QFileInfo &fi, QDir(f).entryInfoList(QDir::AllEntries | QDir::Hidden | QDir::NoDotAndDotDot))
+    {
+        if (!clone(fi.absoluteFilePath(), QDir(t).filePath(fi.fileName())))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FileUtils::cloneFile(const QString &f, const QString &t)
+{
+#ifdef Q_OS_LINUX
+#ifdef FICLONE
+    const int in = ::open(QFile::encodeName(f).constData(), O_RDONLY | O_CLOEXEC);
+    if (in >= 0)
+    {
+        const int out = ::open(QFile::encodeName(t).constData(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        const bool cloned = (out >= 0) && (::ioctl(out, FICLONE, in) == 0);
+        if (out >= 0)
+        {
+            ::close(out);
+        }
+        ::close(in);
+        if (cloned)
+        {
+            return QFile::setPermissions(t, QFile::permissions(f));
+        }
+        QFile::remove(t);
+    }
+#endif
+#elif defined(Q_OS_MAC)
+    if (::clonefile(QFile::encodeName(f).constData(), QFile::encodeName(t).constData(), 0) == 0)
+    {
+        return true;
+    }
+#endif
+    return QFile::copy(f, t);
+}
+
 QString FileUtils::read(const QString &p)
 {
     QString c;
     QFile file(p);
-    if (file.exists() && file.open(QIODevice::ReadOnly | QIODevice::Text))
+    if (file.exists() && file.open(QIODevice::ReadOnly))
     {
-        QTextStream s(&file);
-        s.setCodec(QTextCodec::codecForMib(Preferences::get()->textEncoding()));
-        while (!s.atEnd())
+        const qint64 size = file.size();
+        QByteArray buffer;
+        const char *data = 0;
+        if (size > 0)
+        {
+            // Map the file when possible so pages stream straight into the decoder
+            data = reinterpret_cast<const char *>(file.map(0, size));
+            if (!data)
+            {
+                buffer = file.readAll();
+                data = buffer.constData();
+            }
+        }
+        QTextCodec *codec = QTextCodec::codecForMib(Preferences::get()->textEncoding());
+        if (!codec)
+        {
+            codec = QTextCodec::codecForName(PREF_DEFAULT_TEXT_ENCODING);
+        }
+        codec = QTextCodec::codecForUtfText(QByteArray::fromRawData(data, qMin<qint64>(size, 4)), codec);
+        QTextDecoder decoder(codec);
+        if (size < INT_MAX)
+        {
+            // Past what a QString can hold the reserve would be narrowed to garbage
+            c.reserve(int(size + 1));
+        }
+        for (qint64 i = 0; i < size; i += FILE_READ_CHUNK)
         {
-            c.append(s.readLine());
-            c.append("\n");
+            c.append(decoder.toUnicode(data + i, qMin<qint64>(FILE_READ_CHUNK, size - i)));
         }
         file.close();
+        if (c.contains('\r'))
+        {
+            // Same as the text mode reads before, editors only ever see "\n"
+            QChar *d = c.data();
+            int j = 0;
+            for (int i = 0; i < c.size(); i++)
+            {
+                if (d[i] != '\r')
+                {
+                    d[j++] = d[i];
+                }
+            }
+            c.truncate(j);
+        }
+        if (!c.isEmpty() && !c.endsWith('\n'))
+        {
+            c.append('\n');
+        }
     }
     return c;
 }
@@ -1,11 +1,13 @@
 #include <QCloseEvent>
 #include <QDesktopServices>
+#include <QDirIterator>
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QMimeData>
 #include <QProcess>
 #include <QProgressBar>
 #include <QTimer>
+#include "include/apkdock.h"
 #include "include/buildrunnable.h"
 #include "include/constants.h"
 #include "include/editortabs.h"
@@ -13,14 +15,16 @@
 #include "include/ide.h"
 #include "include/fileutils.h"
 #include "include/installrunnable.h"
+#include "include/jobsdock.h"
 #include "include/menubar.h"
 #include "include/pathutils.h"
-#include "include/pleasewait.h"
 #include "include/preferences.h"
 #include "include/preopenapk.h"
+#include "include/preopenapks.h"
 #include "include/process.h"
 #include "include/qrc.h"
 #include "include/runner.h"
+#include "include/searchdock.h"
 #include "include/settingseditor.h"
 #include "include/signexportapk.h"
 #include "include/signrunnable.h"
@@ -31,8 +35,20 @@
 
 APP_NAMESPACE_START
 
+static QStringList findApks(const QString &dir)
+{
+    QStringList apks;
+    QDirIterator it(dir, QStringList("*.apk"), QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext())
+    {
+        apks << it.next();
+    }
+    apks.sort();
+    return apks;
+}
+
 Ide::Ide(QWidget *parent)
-    : QMainWindow(parent)
+    : QMainWindow(parent), _install(0)
 {
     _signed = false;
     addToolBar(Qt::TopToolBarArea, new ToolBar(this));
@@ -45,17 +61,31 @@ Ide::Ide(QWidget *parent)
     setWindowIcon(QIcon(Qrc::image("logo")));
     setWindowTitle(__("ide", "titles"));
     // Docks : Begin
+    QDockWidget *apk;
     QDockWidget *console;
+    QDockWidget *jobs;
     QDockWidget *project;
+    QDockWidget *search;
     addDockWidget(Qt::BottomDockWidgetArea, console = new ConsoleDock(this));
+    addDockWidget(Qt::BottomDockWidgetArea, jobs = new JobsDock(this));
     addDockWidget(Qt::LeftDockWidgetArea, project = new ProjectDock(this));
+    addDockWidget(Qt::LeftDockWidgetArea, apk = new ApkDock(this));
+    addDockWidget(Qt::BottomDockWidgetArea, search = new SearchDock(this));
+    tabifyDockWidget(console, jobs);
+    tabifyDockWidget(console, search);
+    tabifyDockWidget(project, apk);
+    console->raise();
+    project->raise();
     // Docks : End
     // Widgets : Begin
     WidgetBar *bottom = new WidgetBar(this);
     WidgetBar *left = new WidgetBar(this);
     bottom->addWidget(Qrc::icon("dock_console"), console);
+    bottom->addWidget(Qrc::icon("toolbar_build"), jobs);
+    bottom->addWidget(Qrc::icon("dock_search"), search);
     bottom->setObjectName("BottomWidgetBar");
     left->addWidget(Qrc::icon("dock_project"), project);
+    left->addWidget(Qrc::icon("toolbar_apk"), apk);
     left->setObjectName("LeftWidgetBar");
     addToolBar(Qt::BottomToolBarArea, bottom);
     addToolBar(Qt::LeftToolBarArea, left);
@@ -92,6 +122,7 @@ void Ide::dropEvent(QDropEvent *e)
     const QMimeData* data = e->mimeData();
     if (data->hasUrls())
     {
+        QStringList apks;
         QList<QUrl> urls = data->urls();
         for (int i = 0; i < urls.size(); i++)
         {
@@ -99,9 +130,11 @@ void Ide::dropEvent(QDropEvent *e)
             QString suffix = QFileInfo(p).suffix();
             if (QString::compare(suffix, "apk", Qt::CaseInsensitive) == 0)
             {
-                onOpenApk(p);
-                accepted = true;
-                break;
+                apks << p;
+            }
+            else if (QFileInfo(p).isDir())
+            {
+                apks << findApks(p);
             }
             else if (QString(EDITOR_EXT_CODER).contains(suffix, Qt::CaseInsensitive) || QString(EDITOR_EXT_VIEWER).contains(suffix, Qt::CaseInsensitive))
             {
@@ -109,6 +142,15 @@ void Ide::dropEvent(QDropEvent *e)
                 accepted = true;
             }
         }
+        if (apks.size() == 1)
+        {
+            onOpenApk(apks.first());
+        }
+        else if (apks.size() > 1)
+        {
+            onOpenApks(apks);
+        }
+        accepted = accepted || !apks.isEmpty();
     }
     if (accepted)
     {
@@ -127,6 +169,11 @@ void Ide::onBuildSuccess(const QString &a)
     _statusBar->showMessage(__("build_success", "messages", a));
 }
 
+void Ide::onDecodeBatchFinished(const QString &r, const int s, const int t)
+{
+    _statusBar->showMessage(__("decode_batch_finished", "messages", QString("%1/%2").arg(s).arg(t), r));
+}
+
 void Ide::onDecodeFailure(const QString &a)
 {
     _statusBar->showMessage(__("decode_failure", "messages", a));
@@ -151,8 +198,14 @@ void Ide::onFileOpen(const QString &p)
     emit fileOpen(p);
 }
 
+void Ide::onFileOpenAt(const QString &p, const int l)
+{
+    emit fileOpenAt(p, l);
+}
+
 void Ide::onFileSaved(const QString &p)
 {
+    _saved << p;
     _statusBar->showMessage(__("file_saved", "messages", p));
 }
 
@@ -202,6 +255,25 @@ void Ide::onMenuBarEditSettings()
     (new SettingsEditor(this))->exec();
 }
 
+void Ide::onMenuBarFileBrowseApk()
+{
+    QFileDialog d(this, __("choose_apk", "titles"), Preferences::get()->previousDir(), __("apk", "filters"));
+    d.setAcceptMode(QFileDialog::AcceptOpen);
+    d.setFileMode(QFileDialog::ExistingFile);
+#ifdef NO_NATIVE_DIALOG
+    d.setOption(QFileDialog::DontUseNativeDialog);
+#endif
+    if (d.exec() == QFileDialog::Accepted)
+    {
+        QStringList files;
+        if ((files = d.selectedFiles()).isEmpty() == false)
+        {
+            Preferences::get()->setPreviousDir(d.directory().absolutePath())->save();
+            emit apkBrowse(files.first());
+        }
+    }
+}
+
 void Ide::onMenuBarFileOpenApk()
 {
     QFileDialog d(this, __("choose_apk", "titles"), Preferences::get()->previousDir(), __("apk", "filters"));
@@ -222,6 +294,52 @@ void Ide::onMenuBarFileOpenApk()
     }
 }
 
+void Ide::onMenuBarFileOpenApkFolder()
+{
+    QFileDialog d(this, __("choose_apk_folder", "titles"), Preferences::get()->previousDir());
+    d.setFileMode(QFileDialog::Directory);
+    d.setOptions(QFileDialog::ShowDirsOnly | QFileDialog::DontResolveSymlinks);
+#ifdef NO_NATIVE_DIALOG
+    d.setOption(QFileDialog::DontUseNativeDialog);
+#endif
+    if (d.exec() == QFileDialog::Accepted)
+    {
+        QStringList files;
+        if ((files = d.selectedFiles()).isEmpty() == false)
+        {
+            Preferences::get()->setPreviousDir(files.first())->save();
+            const QStringList apks = findApks(files.first());
+            if (apks.isEmpty())
+            {
+                QMessageBox::warning(this, __("no_apks", "titles"), __("no_apk_in_folder", "messages"), QMessageBox::Close);
+            }
+            else
+            {
+                onOpenApks(apks);
+            }
+        }
+    }
+}
+
+void Ide::onMenuBarFileOpenApks()
+{
+    QFileDialog d(this, __("choose_apks", "titles"), Preferences::get()->previousDir(), __("apk", "filters"));
+    d.setAcceptMode(QFileDialog::AcceptOpen);
+    d.setFileMode(QFileDialog::ExistingFiles);
+#ifdef NO_NATIVE_DIALOG
+    d.setOption(QFileDialog::DontUseNativeDialog);
+#endif
+    if (d.exec() == QFileDialog::Accepted)
+    {
+        QStringList files;
+        if ((files = d.selectedFiles()).isEmpty() == false)
+        {
+            Preferences::get()->setPreviousDir(d.directory().absolutePath())->save();
+            onOpenApks(files);
+        }
+    }
+}
+
 void Ide::onMenuBarFileOpenDir()
 {
     QFileDialog d(this, __("choose_exiting_project", "titles"), Preferences::get()->previousDir(), __("apktool_yml", "filters"));
@@ -325,7 +443,32 @@ void Ide::onMenuBarProjectBuild()
     }
     else
     {
-        Runner::get()->add(new BuildRunnable(_project, TextUtils::rtrim(_project, '/') + ".apk", this));
+        Runner::get()->add(new BuildRunnable(_project, TextUtils::rtrim(_project, '/') + ".apk", _saved, this));
+        _saved.clear();
+    }
+}
+
+/**
+ * @brief Queues the three steps as one chain; each starts only when the
+ * previous one succeeded.
+ */
+void Ide::onMenuBarProjectBuildSignInstall()
+{
+    _signed = false;
+    emit fileSaveAll();
+    if (_project.isNull() || _project.isEmpty())
+    {
+        QMessageBox::warning(this, __("no_project", "titles"), __("no_project", "messages"), QMessageBox::Close);
+    }
+    else
+    {
+        const QString apk = TextUtils::rtrim(_project, '/') + ".apk";
+        Preferences *p = Preferences::get();
+        Runner *r = Runner::get();
+        const int build = r->add(new BuildRunnable(_project, apk, _saved, this));
+        _saved.clear();
+        const int sign = r->add(new SignRunnable(apk, p->signKeystore(), p->signKeystorePass(), p->signKey(), p->signKeyPass(), this), build);
+        _install = r->add(new InstallRunnable(apk, this), sign);
     }
 }
 
@@ -393,6 +536,11 @@ void Ide::onOpenApk(const QString &p)
     (new PreOpenApk(p, this))->exec();
 }
 
+void Ide::onOpenApks(const QStringList &p)
+{
+    (new PreOpenApks(p, this))->exec();
+}
+
 void Ide::onOpenDir(const QString &p)
 {
     _project = p;
@@ -404,21 +552,6 @@ void Ide::onOpenDir(const QString &p)
     }
 }
 
-void Ide::onRunnableStarted()
-{
-    onRunnableStopped();
-    _pleaseWait = new PleaseWait(this);
-    _pleaseWait->show();
-}
-
-void Ide::onRunnableStopped()
-{
-    if (_pleaseWait)
-    {
-        _pleaseWait->finish();
-    }
-}
-
 void Ide::onSignFailure(const QString &a)
 {
     _statusBar->showMessage(__("sign_failure", "messages", a));
@@ -428,6 +561,11 @@ void Ide::onSignSuccess(const QString &a)
 {
     _signed = true;
     _statusBar->showMessage(__("sign_success", "messages", a));
+    if (Runner::get()->state(_install) == Runnable::StateQueued)
+    {
+        // Part of a chain, the install is already on its way
+        return;
+    }
     QMessageBox mb;
     mb.addButton(__("install", "buttons"), QMessageBox::AcceptRole);
     mb.addButton(QMessageBox::Close);
@@ -439,6 +577,11 @@ void Ide::onSignSuccess(const QString &a)
     }
 }
 
+void Ide::onSymbolRequested(const QString &s, const bool u)
+{
+    emit symbolRequested(s, u);
+}
+
 Ide::~Ide()
 {
     Preferences::get()
@@ -1,18 +1,20 @@
+#include <QFileInfo>
 #include "include/adb.h"
+#include "include/constants.h"
 #include "include/installrunnable.h"
+#include "include/qrc.h"
 
 APP_NAMESPACE_START
 
 InstallRunnable::InstallRunnable(const QString &a, QObject *p)
-    : Runnable(p), _apk(a)
+    : Runnable(__("install", "jobs", QFileInfo(a).fileName()), RUNNER_RESOURCE_ADB, p), _apk(a)
 {
     _connections << connect(this, SIGNAL(installFailure(QString)), p, SLOT(onInstallFailure(QString)), Qt::QueuedConnection);
     _connections << connect(this, SIGNAL(installSuccess(QString)), p, SLOT(onInstallSuccess(QString)), Qt::QueuedConnection);
 }
 
-void InstallRunnable::run()
+bool InstallRunnable::execute()
 {
-    emit runnableStarted();
     Process::Result r = Adb::get()->install(_apk);
     if (r.code == 0)
     {
@@ -28,16 +30,11 @@ void InstallRunnable::run()
         if (s)
         {
             emit installSuccess(_apk);
+            return true;
         }
-        else
-        {
-            emit installFailure(_apk);
-        }
-    }
-    else
-    {
     }
-    emit runnableStopped();
+    emit installFailure(_apk);
+    return false;
 }
 
 APP_NAMESPACE_END
@@ -1,5 +1,7 @@
+#include <QFileInfo>
 #include "include/constants.h"
 #include "include/java.h"
+#include "include/javaworker.h"
 #include "include/preferences.h"
 
 APP_NAMESPACE_START
@@ -22,6 +24,34 @@ Process::Result Java::exec(const QStringList &a)
     return Process::exec(QStringList(heap) << a);
 }
 
+/**
+ * @brief Runs the jar in the resident worker when enabled. Only Runner jobs,
+ * which carry a cancel token, use it; one-off calls like version probes never
+ * wait for a worker to start.
+ */
+Process::Result Java::execJar(const QString &jar, const QStringList &a)
+{
+    Preferences *p = Preferences::get();
+    const int heap = p->javaHeap();
+    JavaWorker *worker = 0;
+    const CancelToken cancel = cancelToken();
+    if (p->javaWorker() && cancel)
+    {
+        worker = JavaWorker::acquire(exe(), heap, qMax(1, p->parallelJobs()));
+    }
+    if (worker && worker->send(jar, a))
+    {
+        emit executing(QFileInfo(exe()).completeBaseName(), QStringList(QString("-Xmx%1m").arg(heap)) << "-jar" << jar << a);
+        Result result;
+        result.code = worker->receive(cancel, [this, &result](const QStringList &lines, const bool error) { push(lines, error, result); });
+        JavaWorker::release(worker);
+        emit executed(result);
+        return result;
+    }
+    JavaWorker::release(worker);
+    return exec(QStringList("-jar") << jar << a);
+}
+
 Java *Java::get()
 {
     if (!_self)
@@ -35,7 +65,8 @@ QString Java::getVersion()
 {
     Process::Result r = exec("-version");
     QRegularExpression rgx(REGEX_JAVA_VERSION);
-    foreach (const QString &l, r.output)
+    // Java prints its version on stderr
+    foreach (const QString &l, r.error + r.output)
     {
         QRegularExpressionMatch m = rgx.match(l);
         if (m.hasMatch())
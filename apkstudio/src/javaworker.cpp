@@ -0,0 +1,386 @@
+#include <QAtomicInt>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QMutex>
+#include <QList>
+#include <QSaveFile>
+#include <QUrl>
+#include "include/constants.h"
+#include "include/javaworker.h"
+#include "include/pathutils.h"
+#include "include/preferences.h"
+
+APP_NAMESPACE_START
+
+static QAtomicInt permissive(0);
+
+static QAtomicInt unavailable(0);
+
+/**
+ * @brief Guards the workers below; generation goes up with every stopAll() so
+ * workers busy at the time are stopped once they are released.
+ */
+static QMutex lock;
+
+static int capacity = 1;
+
+static int generation = 0;
+
+static QList<JavaWorker *> spare;
+
+static int workers = 0;
+
+/**
+ * @brief Copies the worker source out of the resources, once per version.
+ */
+static QString source()
+{
+    static QMutex mutex;
+    QMutexLocker locker(&mutex);
+    const QString dir = PathUtils::combine(Preferences::get()->appPath(), FOLDER_WORKER);
+    const QString path = PathUtils::combine(dir, JAVA_WORKER_SOURCE);
+    QFile resource(QString(QRC_WORKER).arg(JAVA_WORKER_SOURCE));
+    if (!resource.open(QIODevice::ReadOnly))
+    {
+        return QString();
+    }
+    const QByteArray bytes = resource.readAll();
+    QFile existing(path);
+    if (existing.open(QIODevice::ReadOnly) && (existing.readAll() == bytes))
+    {
+        return path;
+    }
+    existing.close();
+    QSaveFile file(path);
+    if (!QDir().mkpath(dir) || !file.open(QIODevice::WriteOnly))
+    {
+        return QString();
+    }
+    file.write(bytes);
+    return file.commit() ? path : QString();
+}
+
+JavaWorker::JavaWorker(const QString &j, const int h, const int g)
+    : _generation(g), _heap(h), _java(j), _process(0), _running(0), _stopping(false)
+{
+}
+
+/**
+ * @brief Idle worker for the calling job, or a new one while fewer than limit
+ * exist. Workers that died or run another Java or heap are replaced. Null if
+ * all are busy or no worker can be run, e.g. because the installed Java
+ * cannot launch source files (before 11) or will not let the worker trap
+ * System.exit() (24 on); callers fall back to java -jar then.
+ */
+JavaWorker *JavaWorker::acquire(const QString &j, const int h, const int l)
+{
+    if (unavailable.load())
+    {
+        return 0;
+    }
+    QList<JavaWorker *> stale;
+    JavaWorker *worker = 0;
+    bool create = false;
+    int g;
+    {
+        QMutexLocker locker(&lock);
+        capacity = l;
+        g = generation;
+        while (!worker && !spare.isEmpty())
+        {
+            JavaWorker *w = spare.takeLast();
+            if (w->_running.load() && (w->_heap == h) && (w->_java == j))
+            {
+                worker = w;
+            }
+            else
+            {
+                stale << w;
+                workers--;
+            }
+        }
+        if (!worker && (workers < l))
+        {
+            workers++;
+            create = true;
+        }
+    }
+    qDeleteAll(stale);
+    if (!create)
+    {
+        return worker;
+    }
+    worker = new JavaWorker(j, h, g);
+    worker->start();
+    bool started = false;
+    worker->call([worker, &started]() { started = worker->spawn(); });
+    if (!started)
+    {
+        unavailable.store(1);
+        delete worker;
+        QMutexLocker locker(&lock);
+        workers--;
+        return 0;
+    }
+    return worker;
+}
+
+/**
+ * @brief Runs the function on the worker's thread and waits for it.
+ */
+void JavaWorker::call(const std::function<void()> &f)
+{
+    QMutexLocker locker(&_mutex);
+    _call = f;
+    _wake.wakeOne();
+    while (_call)
+    {
+        _done.wait(&_mutex);
+    }
+}
+
+/**
+ * @brief Output of the request sent last, passed on as it arrives, and its
+ * exit code. A stuck or cancelled tool is killed along with the worker.
+ */
+int JavaWorker::collect(const CancelToken &cancel, const Sink &sink)
+{
+    QElapsedTimer idle;
+    idle.start();
+    int code = -1;
+    forever
+    {
+        if (!_process->canReadLine())
+        {
+            _process->waitForReadyRead(PROCESS_POLL_INTERVAL);
+        }
+        const bool running = _process->state() == QProcess::Running;
+        QStringList lines[2];
+        bool done = false;
+        bool received = false;
+        while (!done && _process->canReadLine())
+        {
+            const QByteArray line = _process->readLine();
+            const QString text = QString::fromUtf8(line.constData() + qMin(2, line.size()), qMax(0, line.size() - 3));
+            received = true;
+            if (line.startsWith("O "))
+            {
+                lines[0] << text;
+            }
+            else if (line.startsWith("E "))
+            {
+                lines[1] << text;
+            }
+            else if (line.startsWith("X "))
+            {
+                code = text.toInt();
+                done = true;
+            }
+        }
+        for (int c = 0; c < 2; c++)
+        {
+            if (!lines[c].isEmpty())
+            {
+                sink(lines[c], c == 1);
+            }
+        }
+        if (done)
+        {
+            return code;
+        }
+        if (!running)
+        {
+            // The tool took the JVM down with it, its exit code is the result
+            return (_process->exitStatus() == QProcess::NormalExit) ? _process->exitCode() : -1;
+        }
+        if (received)
+        {
+            idle.restart();
+        }
+        if (idle.hasExpired(CLI_TIMEOUT) || (cancel && cancel->load()))
+        {
+            _process->kill();
+            _process->waitForFinished();
+            return -1;
+        }
+    }
+}
+
+/**
+ * @brief Starts the worker JVM and waits for it to report in. Returns 1 when
+ * it traps System.exit(), 0 when it does not, and -1 when it did not start.
+ */
+int JavaWorker::launch(const bool allow)
+{
+    const QString path = source();
+    if (path.isEmpty())
+    {
+        return -1;
+    }
+    QStringList args(QString("-Xmx%1m").arg(_heap));
+    if (allow)
+    {
+        args << "-Djava.security.manager=allow";
+    }
+    _process->start(_java, args << path, QIODevice::ReadWrite);
+    if (!_process->waitForStarted(CLI_TIMEOUT))
+    {
+        return -1;
+    }
+    // The source is compiled on launch, which takes a moment the first time
+    QElapsedTimer timer;
+    timer.start();
+    while (!timer.hasExpired(JAVA_WORKER_START_TIMEOUT) && (_process->state() == QProcess::Running))
+    {
+        while (_process->canReadLine())
+        {
+            const QByteArray line = _process->readLine().trimmed();
+            if (line.startsWith("READY"))
+            {
+                return (line == "READY 1") ? 1 : 0;
+            }
+        }
+        _process->waitForReadyRead(PROCESS_POLL_INTERVAL);
+    }
+    _process->kill();
+    _process->waitForFinished();
+    return -1;
+}
+
+bool JavaWorker::post(const QString &jar, const QStringList &args)
+{
+    QByteArray request = QUrl::toPercentEncoding(jar);
+    foreach (const QString &a, args)
+    {
+        request.append('\t');
+        request.append(QUrl::toPercentEncoding(a));
+    }
+    request.append('\n');
+    return (_process->write(request) == request.size()) && _process->waitForBytesWritten(CLI_TIMEOUT);
+}
+
+int JavaWorker::receive(const CancelToken &cancel, const Sink &sink)
+{
+    int code = -1;
+    call([this, &cancel, &code, &sink]() { code = collect(cancel, sink); });
+    return code;
+}
+
+/**
+ * @brief Hands a worker back once its job is done. It is kept for the next
+ * job unless it died, stopAll() ran meanwhile or the limit went down.
+ */
+void JavaWorker::release(JavaWorker *w)
+{
+    if (!w)
+    {
+        return;
+    }
+    {
+        QMutexLocker locker(&lock);
+        if (w->_running.load() && (w->_generation == generation) && (workers <= capacity))
+        {
+            spare << w;
+            return;
+        }
+        workers--;
+    }
+    delete w;
+}
+
+void JavaWorker::run()
+{
+    QProcess process;
+    process.setStandardErrorFile(QProcess::nullDevice());
+    _process = &process;
+    QMutexLocker locker(&_mutex);
+    forever
+    {
+        while (!_call && !_stopping)
+        {
+            _wake.wait(&_mutex);
+        }
+        if (!_call)
+        {
+            break;
+        }
+        locker.unlock();
+        _call();
+        _running.store(process.state() == QProcess::Running);
+        locker.relock();
+        _call = std::function<void()>();
+        _done.wakeAll();
+    }
+    locker.unlock();
+    if (process.state() != QProcess::NotRunning)
+    {
+        // End of input makes the worker quit on its own
+        process.closeWriteChannel();
+        if (!process.waitForFinished(PROCESS_POLL_INTERVAL))
+        {
+            process.kill();
+            process.waitForFinished();
+        }
+    }
+    _process = 0;
+}
+
+bool JavaWorker::send(const QString &jar, const QStringList &args)
+{
+    bool sent = false;
+    call([this, &args, &jar, &sent]() { sent = post(jar, args); });
+    return sent;
+}
+
+/**
+ * @brief A worker that cannot trap System.exit() would die with every tool
+ * that exits and be slower than plain java -jar, so it is not used. JVMs from
+ * 18 on need the security manager allowed explicitly, which 11 does not
+ * understand and 24 refuses; what worked is remembered.
+ */
+bool JavaWorker::spawn()
+{
+    int trapped = launch(permissive.load());
+    if ((trapped == 0) && !permissive.load())
+    {
+        _process->kill();
+        _process->waitForFinished();
+        permissive.store(1);
+        trapped = launch(true);
+    }
+    if (trapped != 1)
+    {
+        _process->kill();
+        _process->waitForFinished();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Stops every idle worker now and every busy one once its job is done.
+ */
+void JavaWorker::stopAll()
+{
+    QList<JavaWorker *> stopping;
+    {
+        QMutexLocker locker(&lock);
+        generation++;
+        workers -= spare.size();
+        stopping.swap(spare);
+    }
+    qDeleteAll(stopping);
+}
+
+JavaWorker::~JavaWorker()
+{
+    {
+        QMutexLocker locker(&_mutex);
+        _stopping = true;
+        _wake.wakeOne();
+    }
+    wait();
+}
+
+APP_NAMESPACE_END
@@ -0,0 +1,123 @@
+#include <QHeaderView>
+#include <QMenu>
+#include "include/jobsdock.h"
+#include "include/qrc.h"
+#include "include/runner.h"
+
+APP_NAMESPACE_START
+
+static QString stateText(const int s)
+{
+    switch (s)
+    {
+    case Runnable::StateQueued:
+        return __("queued", "jobs");
+    case Runnable::StateRunning:
+        return __("running", "jobs");
+    case Runnable::StateSucceeded:
+        return __("succeeded", "jobs");
+    case Runnable::StateFailed:
+        return __("failed", "jobs");
+    default:
+        return __("cancelled", "jobs");
+    }
+}
+
+JobsDock::JobsDock(QWidget *p)
+    : QDockWidget(__("jobs", "docks"), p)
+{
+    _tree = new QTreeWidget(this);
+    _tree->setColumnCount(2);
+    _tree->setContextMenuPolicy(Qt::CustomContextMenu);
+    _tree->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    _tree->setRootIsDecorated(false);
+    _tree->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    _tree->setUniformRowHeights(true);
+    _tree->header()->hide();
+    _tree->header()->setStretchLastSection(false);
+    _tree->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+    _tree->header()->setSectionResizeMode(1, QHeaderView::ResizeToContents);
+    _connections << connect(_tree, &QTreeWidget::customContextMenuRequested, this, &JobsDock::onContextMenuRequested);
+    _connections << connect(Runner::get(), &Runner::jobAdded, this, &JobsDock::onJobAdded);
+    _connections << connect(Runner::get(), &Runner::jobChanged, this, &JobsDock::onJobChanged);
+    setContentsMargins(2, 2, 2, 2);
+    setObjectName("JobsDock");
+    setWidget(_tree);
+}
+
+void JobsDock::onContextMenuRequested(const QPoint &p)
+{
+    QList<int> active;
+    foreach (QTreeWidgetItem *item, _tree->selectedItems())
+    {
+        const int s = item->data(0, RoleState).toInt();
+        if ((s == Runnable::StateQueued) || (s == Runnable::StateRunning))
+        {
+            active << item->data(0, RoleJob).toInt();
+        }
+    }
+    QMenu menu(this);
+    QAction *cancel = menu.addAction(__("cancel", "jobs"));
+    QAction *clear = menu.addAction(__("clear_finished", "jobs"));
+    cancel->setEnabled(!active.isEmpty());
+    QAction *chosen = menu.exec(_tree->viewport()->mapToGlobal(p));
+    if (chosen == cancel)
+    {
+        foreach (const int id, active)
+        {
+            Runner::get()->cancel(id);
+        }
+    }
+    else if (chosen == clear)
+    {
+        QHash<int, QTreeWidgetItem *>::iterator it = _items.begin();
+        while (it != _items.end())
+        {
+            const int s = it.value()->data(0, RoleState).toInt();
+            if ((s != Runnable::StateQueued) && (s != Runnable::StateRunning))
+            {
+                delete it.value();
+                it = _items.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+}
+
+void JobsDock::onJobAdded(const int id, const QString &t)
+{
+    QTreeWidgetItem *item = new QTreeWidgetItem(_tree);
+    item->setData(0, RoleJob, id);
+    item->setData(0, RoleState, Runnable::StateQueued);
+    item->setText(0, t);
+    item->setText(1, stateText(Runnable::StateQueued));
+    _items.insert(id, item);
+    _tree->scrollToItem(item);
+}
+
+void JobsDock::onJobChanged(const int id, const int s)
+{
+    QTreeWidgetItem *item = _items.value(id);
+    if (item)
+    {
+        item->setData(0, RoleState, s);
+        if ((s == Runnable::StateQueued) || (s == Runnable::StateRunning))
+        {
+            item->setText(1, stateText(s));
+        }
+        else
+        {
+            item->setText(1, __("elapsed", "jobs", stateText(s), QString::number(Runner::get()->elapsed(id) / 1000.0, 'f', 1)));
+        }
+    }
+}
+
+JobsDock::~JobsDock()
+{
+    APP_CONNECTIONS_DISCONNECT
+}
+
+APP_NAMESPACE_END
@@ -0,0 +1,207 @@
+#include <QtAlgorithms>
+#include "include/constants.h"
+#include "include/lineindex.h"
+#ifdef LINEINDEX_BENCHMARK
+#include <QDebug>
+#include <QElapsedTimer>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define LINEINDEX_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define LINEINDEX_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Every scanner appends the offset just past each break, i.e. where the next line starts.
+ */
+static void scanScalar(const uchar *data, qint64 i, const qint64 size, const bool cr, QVector<qint64> &ends)
+{
+    for (; i < size; i++)
+    {
+        if ((data[i] == '\n') || (cr && (data[i] == '\r')))
+        {
+            ends << (i + 1);
+        }
+    }
+}
+
+static void scanScalar(const ushort *data, int i, const int size, const bool cr, QVector<int> &ends)
+{
+    for (; i < size; i++)
+    {
+        if ((data[i] == '\n') || (cr && (data[i] == '\r')))
+        {
+            ends << (i + 1);
+        }
+    }
+}
+
+#ifdef LINEINDEX_SSE2
+static qint64 scanSse2(const uchar *data, const qint64 size, const bool cr, QVector<qint64> &ends)
+{
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i other = _mm_set1_epi8(cr ? '\r' : '\n');
+    qint64 i = 0;
+    for (; (i + 16) <= size; i += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        quint32 mask = quint32(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, lf), _mm_cmpeq_epi8(chunk, other))));
+        while (mask)
+        {
+            ends << (i + qCountTrailingZeroBits(mask) + 1);
+            mask &= mask - 1;
+        }
+    }
+    return i;
+}
+
+static int scanSse2(const ushort *data, const int size, const bool cr, QVector<int> &ends)
+{
+    const __m128i lf = _mm_set1_epi16('\n');
+    const __m128i other = _mm_set1_epi16(cr ? '\r' : '\n');
+    int i = 0;
+    for (; (i + 8) <= size; i += 8)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+        // Two mask bits per character, drop the odd ones
+        quint32 mask = quint32(_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi16(chunk, lf), _mm_cmpeq_epi16(chunk, other)))) & 0x5555;
+        while (mask)
+        {
+            ends << (i + int(qCountTrailingZeroBits(mask) / 2) + 1);
+            mask &= mask - 1;
+        }
+    }
+    return i;
+}
+#endif
+
+#ifdef LINEINDEX_AVX2
+__attribute__((target("avx2")))
+static qint64 scanAvx2(const uchar *data, const qint64 size, const bool cr, QVector<qint64> &ends)
+{
+    const __m256i lf = _mm256_set1_epi8('\n');
+    const __m256i other = _mm256_set1_epi8(cr ? '\r' : '\n');
+    qint64 i = 0;
+    for (; (i + 32) <= size; i += 32)
+    {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+        quint32 mask = quint32(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, lf), _mm256_cmpeq_epi8(chunk, other))));
+        while (mask)
+        {
+            ends << (i + qCountTrailingZeroBits(mask) + 1);
+            mask &= mask - 1;
+        }
+    }
+    return i;
+}
+
+static bool hasAvx2()
+{
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+#endif
+
+QVector<qint64> LineIndex::build(const uchar *data, const qint64 size)
+{
+#ifdef LINEINDEX_BENCHMARK
+    QElapsedTimer timer;
+    timer.start();
+#endif
+    QVector<qint64> starts;
+    starts.reserve(int(qMin<qint64>((size / 32) + 1, 1 << 24)));
+    starts << 0;
+    scan(data, size, false, starts);
+#ifdef LINEINDEX_BENCHMARK
+    const qint64 elapsed = qMax<qint64>(timer.nsecsElapsed(), 1);
+    qDebug() << "LineIndex::build:" << starts.size() << "lines in" << size << "bytes," << ((size * 1000) / elapsed) << "MB/s";
+#endif
+    return starts;
+}
+
+QVector<int> LineIndex::build(const QString &text)
+{
+    QVector<int> starts;
+    starts << 0;
+    scan(text.utf16(), text.size(), false, starts);
+    return starts;
+}
+
+void LineIndex::scan(const uchar *data, const qint64 size, const bool cr, QVector<qint64> &ends)
+{
+    qint64 i = 0;
+#ifdef LINEINDEX_AVX2
+    if (hasAvx2())
+    {
+        i = scanAvx2(data, size, cr, ends);
+    }
+    else
+#endif
+    {
+#ifdef LINEINDEX_SSE2
+        i = scanSse2(data, size, cr, ends);
+#endif
+    }
+    scanScalar(data, i, size, cr, ends);
+}
+
+void LineIndex::scan(const ushort *data, const int size, const bool cr, QVector<int> &ends)
+{
+    int i = 0;
+#ifdef LINEINDEX_SSE2
+    i = scanSse2(data, size, cr, ends);
+#endif
+    scanScalar(data, i, size, cr, ends);
+}
+
+/**
+ * @brief Same as splitting on "[\r\n]" with QString::SkipEmptyParts, decoding each line as UTF-8.
+ */
+QStringList LineIndex::split(const QByteArray &data)
+{
+    QVector<qint64> ends;
+    scan(reinterpret_cast<const uchar *>(data.constData()), data.size(), true, ends);
+    ends << (data.size() + 1);
+    QStringList lines;
+    lines.reserve(ends.size());
+    qint64 start = 0;
+    foreach (const qint64 end, ends)
+    {
+        if ((end - 1) > start)
+        {
+            lines << QString::fromUtf8(data.constData() + start, int(end - 1 - start));
+        }
+        start = end;
+    }
+    return lines;
+}
+
+/**
+ * @brief Same as splitting on "[\r\n]" with QString::SkipEmptyParts.
+ */
+QStringList LineIndex::split(const QString &text)
+{
+    QVector<int> ends;
+    scan(text.utf16(), text.size(), true, ends);
+    ends << (text.size() + 1);
+    QStringList lines;
+    lines.reserve(ends.size());
+    int start = 0;
+    foreach (const int end, ends)
+    {
+        if ((end - 1) > start)
+        {
+            lines << text.mid(start, end - 1 - start);
+        }
+        start = end;
+    }
+    return lines;
+}
+
+APP_NAMESPACE_END
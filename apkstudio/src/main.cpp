@@ -5,16 +5,20 @@
 #include <QStyleFactory>
 #include <QTimer>
 #include <QTranslator>
+#include "include/coderhighlighterworker.h"
 #include "include/constants.h"
 #include "include/ide.h"
 #include "include/fileutils.h"
 #include "include/process.h"
+#include "include/searchworker.h"
 
 using namespace APP_NAMESPACE;
 
 int main(int argc, char *argv[])
 {
+    qRegisterMetaType<CoderHighlighterChunk>("CoderHighlighterChunk");
     qRegisterMetaType<Process::Result>("Result");
+    qRegisterMetaType<SearchMatchList>("SearchMatchList");
     QCoreApplication::setApplicationName(APP_NAME);
     QCoreApplication::setOrganizationName(APP_ORGANIZATION);
     QFontDatabase::addApplicationFont(QString(QRC_FONTS).append("scp_regular.ttf"));
@@ -27,7 +27,10 @@ void MenuBar::addEditMenu()
     m->addSeparator();
     m->addAction(__("find", "menubar"), parent(), SLOT(onMenuBarEditFind()), QKeySequence::Find);
     m->addAction(__("replace", "menubar"), parent(), SLOT(onMenuBarEditReplace()), QKeySequence::Replace);
+    m->addAction(__("find_in_files", "menubar"), parent(), SLOT(onMenuBarEditFindInFiles()), QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_F));
     m->addAction(__("goto", "menubar"), parent(), SLOT(onMenuBarEditGoto()));
+    m->addAction(__("goto_definition", "menubar"), parent(), SLOT(onMenuBarEditGotoDefinition()), QKeySequence(Qt::Key_F12));
+    m->addAction(__("find_usages", "menubar"), parent(), SLOT(onMenuBarEditFindUsages()), QKeySequence(Qt::SHIFT | Qt::Key_F12));
     m->addSeparator();
     m->addAction(__("settings", "menubar"), parent(), SLOT(onMenuBarEditSettings()), QKeySequence::Preferences);
     addAction(m->menuAction());
@@ -38,6 +41,9 @@ void MenuBar::addFileMenu()
     QMenu *m = new QMenu(__("file", "menubar"), this);
     QMenu *o = new QMenu(__("open", "menubar"), m);
     o->addAction(__("apk", "menubar"), parent(), SLOT(onMenuBarFileOpenApk()), QKeySequence::New);
+    o->addAction(__("apks", "menubar"), parent(), SLOT(onMenuBarFileOpenApks()));
+    o->addAction(__("apk_folder", "menubar"), parent(), SLOT(onMenuBarFileOpenApkFolder()));
+    o->addAction(__("apk_contents", "menubar"), parent(), SLOT(onMenuBarFileBrowseApk()), QKeySequence(Qt::CTRL | Qt::SHIFT | Qt::Key_O));
     o->addAction(__("directory", "menubar"), parent(), SLOT(onMenuBarFileOpenDir()), QKeySequence::Open);
     o->addSeparator();
     o->addAction(__("file", "menubar"), parent(), SLOT(onMenuBarFileOpenFile()));
@@ -75,6 +81,7 @@ void MenuBar::addProjectMenu()
     m->addAction(__("reload", "menubar"), parent(), SLOT(onMenuBarProjectReload()));
     m->addSeparator();
     m->addAction(__("build", "menubar"), parent(), SLOT(onMenuBarProjectBuild()), Qt::Key_F5);
+    m->addAction(__("build_sign_install", "menubar"), parent(), SLOT(onMenuBarProjectBuildSignInstall()), Qt::SHIFT + Qt::Key_F5);
     m->addSeparator();
     m->addAction(__("sign_export", "menubar"), parent(), SLOT(onMenuBarProjectSignExport()));
     m->addAction(__("install", "menubar"), parent(), SLOT(onMenuBarProjectInstall()));
@@ -1,4 +1,6 @@
 #include <QDir>
+#include <QHash>
+#include <QMutex>
 #include <QStandardPaths>
 #include "include/constants.h"
 #include "include/pathutils.h"
@@ -12,7 +14,33 @@ QString PathUtils::combine(const QString &l, const QString &r)
     return TextUtils::rtrim(l, '/') + '/' + TextUtils::ltrim(r, '/');
 }
 
+/**
+ * @brief Found paths are remembered per vendor path; a remembered one is used
+ * for as long as it exists.
+ */
 QString PathUtils::find(const QString &exe)
+{
+    static QHash<QString, QString> found;
+    static QMutex mutex;
+    const QString key = Preferences::get()->vendorPath() + '\n' + exe;
+    {
+        QMutexLocker locker(&mutex);
+        const QString path = found.value(key);
+        if (!path.isEmpty() && QFile::exists(path))
+        {
+            return path;
+        }
+    }
+    const QString path = lookup(exe);
+    if (path != exe)
+    {
+        QMutexLocker locker(&mutex);
+        found.insert(key, path);
+    }
+    return path;
+}
+
+QString PathUtils::lookup(const QString &exe)
 {
     QString vendor;
     if (QFile::exists(vendor = PathUtils::combine(Preferences::get()->vendorPath(), exe)))
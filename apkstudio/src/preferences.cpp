@@ -24,18 +24,25 @@ Preferences *Preferences::get()
     return _self;
 }
 
+/**
+ * @brief Settings are also read by jobs running side by side, so access to
+ * the shared QSettings is serialized.
+ */
 QVariant Preferences::get(const QString &k, const QVariant &f)
 {
+    QMutexLocker locker(&_mutex);
     return _settings->value(k, f);
 }
 
 void Preferences::save()
 {
+    QMutexLocker locker(&_mutex);
     _settings->sync();
 }
 
 Preferences *Preferences::set(const QString &k, const QVariant &v)
 {
+    QMutexLocker locker(&_mutex);
     _settings->setValue(k, v);
     return this;
 }
@@ -58,6 +65,16 @@ int Preferences::javaHeap()
     return get(PREF_JAVA_HEAP, PREF_DEFAULT_JAVA_HEAP).toInt();
 }
 
+bool Preferences::javaWorker()
+{
+    return get(PREF_JAVA_WORKER, false).toBool();
+}
+
+int Preferences::parallelJobs()
+{
+    return get(PREF_PARALLEL_JOBS, PREF_DEFAULT_PARALLEL_JOBS).toInt();
+}
+
 QString Preferences::previousDir()
 {
     QString d = get(PREF_PREVIOUS_DIR).toString();
@@ -137,6 +154,11 @@ QString Preferences::vendorPath()
     return pref;
 }
 
+int Preferences::viewerThreshold()
+{
+    return get(PREF_VIEWER_THRESHOLD, PREF_DEFAULT_VIEWER_THRESHOLD).toInt();
+}
+
 bool Preferences::wasWindowMaximized()
 {
     return get(PREF_WINDOW_MAXIMIZED).toBool();
@@ -160,6 +182,16 @@ Preferences *Preferences::setJavaHeap(const int mb)
     return set(PREF_JAVA_HEAP, mb);
 }
 
+Preferences *Preferences::setJavaWorker(const bool u)
+{
+    return set(PREF_JAVA_WORKER, u);
+}
+
+Preferences *Preferences::setParallelJobs(const int j)
+{
+    return set(PREF_PARALLEL_JOBS, j);
+}
+
 Preferences *Preferences::setPreviousDir(const QString &d)
 {
     return set(PREF_PREVIOUS_DIR, d);
@@ -219,6 +251,11 @@ Preferences *Preferences::setVendorPath(const QString &p)
     return set(PREF_VENDOR_PATH, p);
 }
 
+Preferences *Preferences::setViewerThreshold(const int mb)
+{
+    return set(PREF_VIEWER_THRESHOLD, mb);
+}
+
 Preferences *Preferences::setWindowMaximized(bool m)
 {
     return set(PREF_WINDOW_MAXIMIZED, m);
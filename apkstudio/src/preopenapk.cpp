@@ -6,6 +6,7 @@
 #include <QPushButton>
 #include <QVBoxLayout>
 #include "include/decoderunnable.h"
+#include "include/dexsummary.h"
 #include "include/pathutils.h"
 #include "include/preopenapk.h"
 #include "include/qrc.h"
@@ -41,6 +42,8 @@ PreOpenApk::PreOpenApk(const QString &a, QWidget *p)
     // Form : End
     QVBoxLayout *layout = new QVBoxLayout(this);
     QDialogButtonBox *buttons = new QDialogButtonBox(this);
+    QPushButton *summary = new QPushButton(__("dex_summary", "buttons"), buttons);
+    buttons->addButton(summary, QDialogButtonBox::ActionRole);
     buttons->addButton(new QPushButton(__("cancel", "buttons"), buttons), QDialogButtonBox::RejectRole);
     buttons->addButton(new QPushButton(__("decode", "buttons"), buttons), QDialogButtonBox::AcceptRole);
     layout->addLayout(form);
@@ -48,10 +51,26 @@ PreOpenApk::PreOpenApk(const QString &a, QWidget *p)
     setLayout(layout);
     _apk->setReadOnly(true);
     _connections << connect(browse, SIGNAL(clicked()), this, SLOT(onBrowseProject()));
+    _connections << connect(summary, SIGNAL(clicked()), this, SLOT(onDexSummary()));
     _connections << connect(buttons, SIGNAL(accepted()), this, SLOT(accept()));
     _connections << connect(buttons, SIGNAL(rejected()), this, SLOT(close()));
-    // List Frameworks
-    _framework->addItem("Default");
+    listFrameworks(_framework);
+}
+
+void PreOpenApk::accept()
+{
+    const QString apk = _apk->text();
+    const QString framework = _framework->currentData().toString();
+    const QString project = _project->text();
+    const bool resources = _resources->isChecked();
+    const bool sources = _sources->isChecked();
+    Runner::get()->add(new DecodeRunnable(apk, project, framework, sources, resources, parent()));
+    Dialog::accept();
+}
+
+void PreOpenApk::listFrameworks(QComboBox *c)
+{
+    c->addItem("Default");
     QDirIterator iterator(PathUtils::combine(QDir::homePath(), "apktool/framework"), QDirIterator::Subdirectories);
     while (iterator.hasNext())
     {
@@ -63,23 +82,12 @@ PreOpenApk::PreOpenApk(const QString &a, QWidget *p)
             if (parts.count() == 2)
             {
                 QString tag = name.section('-', 1);
-                _framework->addItem(QString("%1 [%2]").arg(parts.at(0)).arg(tag), tag);
+                c->addItem(QString("%1 [%2]").arg(parts.at(0)).arg(tag), tag);
             }
         }
     }
 }
 
-void PreOpenApk::accept()
-{
-    const QString apk = _apk->text();
-    const QString framework = _framework->currentData().toString();
-    const QString project = _project->text();
-    const bool resources = _resources->isChecked();
-    const bool sources = _sources->isChecked();
-    Runner::get()->add(new DecodeRunnable(apk, project, framework, sources, resources, parent()));
-    Dialog::accept();
-}
-
 void PreOpenApk::onBrowseProject()
 {
     QString dir;
@@ -104,4 +112,9 @@ void PreOpenApk::onBrowseProject()
     }
 }
 
+void PreOpenApk::onDexSummary()
+{
+    DexSummary::display(_apk->text(), this);
+}
+
 APP_NAMESPACE_END
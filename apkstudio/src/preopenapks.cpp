@@ -0,0 +1,120 @@
+#include <QDateTime>
+#include <QDialogButtonBox>
+#include <QDir>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QFormLayout>
+#include <QPushButton>
+#include <QSet>
+#include <QVBoxLayout>
+#include "include/constants.h"
+#include "include/decodebatch.h"
+#include "include/pathutils.h"
+#include "include/preferences.h"
+#include "include/preopenapk.h"
+#include "include/preopenapks.h"
+#include "include/qrc.h"
+
+APP_NAMESPACE_START
+
+PreOpenApks::PreOpenApks(const QStringList &a, QWidget *p)
+    : Dialog(__("decode_apks", "titles", QString::number(a.size())), p), _apks(a)
+{
+#ifdef Q_OS_LINUX
+    setFixedSize(480, 256);
+#else
+    setFixedSize(360, 240);
+#endif
+    setWindowIcon(Qrc::icon("toolbar_apk"));
+    Preferences *pr = Preferences::get();
+    // Form : Start
+    QFormLayout *form = new QFormLayout;
+    QPushButton *browse = new QPushButton(__("browse", "buttons"), this);
+    QLayout *row = new QHBoxLayout;
+    row->addWidget(_output = new QLineEdit(PathUtils::combine(QFileInfo(a.first()).absolutePath(), "decoded"), this));
+    row->addWidget(browse);
+    form->addRow(__("output_path", "forms"), row);
+    form->addRow(__("framework_tag", "forms"), _framework = new QComboBox(this));
+    form->addRow(__("decompile_sources", "forms"), _sources = new QCheckBox(this));
+    form->addRow(__("decode_resources", "forms"), _resources = new QCheckBox(this));
+    form->addRow(__("parallel_jobs", "forms"), _parallelJobs = new QSpinBox(this));
+    _parallelJobs->setMinimum(1);
+    _parallelJobs->setMaximum(THREADS_MAX);
+    _parallelJobs->setValue(pr->parallelJobs());
+    form->addRow(__("java_heap", "forms"), _javaHeap = new QSpinBox(this));
+    _javaHeap->setMinimum(16);
+    _javaHeap->setMaximum(4096);
+    _javaHeap->setSingleStep(4);
+    _javaHeap->setValue(pr->javaHeap());
+    _resources->setChecked(true);
+    _sources->setChecked(true);
+    // Form : End
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    QDialogButtonBox *buttons = new QDialogButtonBox(this);
+    buttons->addButton(new QPushButton(__("cancel", "buttons"), buttons), QDialogButtonBox::RejectRole);
+    buttons->addButton(new QPushButton(__("decode", "buttons"), buttons), QDialogButtonBox::AcceptRole);
+    layout->addLayout(form);
+    layout->addWidget(buttons);
+    setLayout(layout);
+    _connections << connect(browse, SIGNAL(clicked()), this, SLOT(onBrowseOutput()));
+    _connections << connect(buttons, SIGNAL(accepted()), this, SLOT(accept()));
+    _connections << connect(buttons, SIGNAL(rejected()), this, SLOT(close()));
+    PreOpenApk::listFrameworks(_framework);
+}
+
+/**
+ * @brief Every APK gets its own project under the output directory; names
+ * that clash get a numeric suffix.
+ */
+void PreOpenApks::accept()
+{
+    const QString output = _output->text();
+    if (!QDir().mkpath(output))
+    {
+        return;
+    }
+    const QString framework = _framework->currentData().toString();
+    const bool resources = _resources->isChecked();
+    const bool sources = _sources->isChecked();
+    // The heap is read by every JVM as it starts, so it has to be saved before queueing
+    Preferences::get()
+            ->setJavaHeap(_javaHeap->value())
+            ->setParallelJobs(_parallelJobs->value())
+            ->save();
+    const QString report = PathUtils::combine(output, QString("decode-report-%1.txt").arg(QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss")));
+    DecodeBatch *batch = new DecodeBatch(report, parent());
+    connect(batch, SIGNAL(finished(QString, int, int)), parent(), SLOT(onDecodeBatchFinished(QString, int, int)));
+    QSet<QString> names;
+    foreach (const QString &apk, _apks)
+    {
+        const QString base = QFileInfo(apk).completeBaseName();
+        QString name = base;
+        for (int i = 2; names.contains(name.toLower()); i++)
+        {
+            name = QString("%1_%2").arg(base).arg(i);
+        }
+        names.insert(name.toLower());
+        batch->add(apk, PathUtils::combine(output, name), framework, sources, resources);
+    }
+    Dialog::accept();
+}
+
+void PreOpenApks::onBrowseOutput()
+{
+    QFileDialog d(this, __("choose_output_directory", "titles"), _output->text());
+    d.setFileMode(QFileDialog::Directory);
+    d.setOptions(QFileDialog::ShowDirsOnly | QFileDialog::DontResolveSymlinks);
+#ifdef NO_NATIVE_DIALOG
+    d.setOption(QFileDialog::DontUseNativeDialog);
+#endif
+    if (d.exec() == QFileDialog::Accepted)
+    {
+        QStringList files;
+        if ((files = d.selectedFiles()).isEmpty() == false)
+        {
+            _output->setText(files.first());
+        }
+    }
+}
+
+APP_NAMESPACE_END
@@ -1,40 +1,151 @@
+#include <QElapsedTimer>
 #include <QFileInfo>
 #include <QProcess>
+#include <QThread>
+#include <QThreadStorage>
 #include "include/constants.h"
+#include "include/lineindex.h"
 #include "include/pathutils.h"
 #include "include/process.h"
 
 APP_NAMESPACE_START
 
+static QThreadStorage<CancelToken> cancelTokens;
+
 Process::Process(const QString &exe, QObject *parent)
-    : QObject(parent), _exe(PathUtils::find(exe)), _lf(QRegularExpression(REGEX_LF))
+    : QObject(parent), _exe(PathUtils::find(exe))
+{
+}
+
+/**
+ * @brief Token of the calling thread, null when no job set one.
+ */
+CancelToken Process::cancelToken()
 {
+    return cancelTokens.hasLocalData() ? cancelTokens.localData() : CancelToken();
 }
 
+/**
+ * @brief Output is read as it comes. The only time limit is on silence: a
+ * process that prints nothing for CLI_TIMEOUT is considered stuck. A process
+ * is also killed once the cancel token of the calling thread is set.
+ */
 Process::Result Process::exec(const QStringList &args)
 {
     emit executing(QFileInfo(_exe).completeBaseName(), args);
     QProcess process;
-    process.setProcessChannelMode(QProcess::MergedChannels);
     // process.setProcessEnvironment(QProcessEnvironment::systemEnvironment());
     process.start(_exe, args, QIODevice::ReadOnly);
     Result result;
+    result.code = -1;
+    const CancelToken cancel = cancelToken();
     if (process.waitForStarted(CLI_TIMEOUT))
     {
-        if (!process.waitForFinished(CLI_TIMEOUT))
+        QByteArray partial[2];
+        QElapsedTimer idle;
+        idle.start();
+        forever
         {
-            process.kill();
+            process.waitForReadyRead(PROCESS_POLL_INTERVAL);
+            const bool running = process.state() != QProcess::NotRunning;
+            bool received = false;
+            for (int c = 0; c < 2; c++)
+            {
+                const QByteArray data = c ? process.readAllStandardError() : process.readAllStandardOutput();
+                received = received || !data.isEmpty();
+                partial[c].append(data);
+                // Hold a trailing half line back until its end arrives, or the process does
+                const int end = running ? qMax(partial[c].lastIndexOf('\n'), partial[c].lastIndexOf('\r')) : (partial[c].size() - 1);
+                if (end >= 0)
+                {
+                    push(LineIndex::split(partial[c].left(end + 1)), c == 1, result);
+                    partial[c].remove(0, end + 1);
+                }
+            }
+            if (!running)
+            {
+                break;
+            }
+            if (received)
+            {
+                idle.restart();
+            }
+            else if (idle.hasExpired(CLI_TIMEOUT))
+            {
+                process.kill();
+                process.waitForFinished();
+            }
+            if (cancel && cancel->load())
+            {
+                process.kill();
+                process.waitForFinished();
+            }
         }
-        QString error(process.readAllStandardError());
-        QString output(process.readAllStandardOutput());
-        result.code = process.exitCode();
-        result.error = error.split(_lf, QString::SkipEmptyParts);
-        result.output = output.split(_lf, QString::SkipEmptyParts);
-    } else {
-        result.code = -1;
+        result.code = (process.exitStatus() == QProcess::NormalExit) ? process.exitCode() : -1;
     }
     emit executed(result);
     return result;
 }
 
+void Process::push(const QStringList &lines, const bool error, Result &result)
+{
+    if (lines.isEmpty())
+    {
+        return;
+    }
+    // Version checks read the first lines and install results the last, so the middle of long output is what goes
+    QStringList &kept = error ? result.error : result.output;
+    kept.append(lines);
+    if (kept.size() > (PROCESS_RESULT_HEAD + PROCESS_RESULT_LINES))
+    {
+        kept.erase(kept.begin() + PROCESS_RESULT_HEAD, kept.end() - PROCESS_RESULT_LINES);
+    }
+    if (receivers(SIGNAL(outputReady())) <= 0)
+    {
+        return;
+    }
+    QMutexLocker locker(&_mutex);
+    const bool waits = QThread::currentThread() != thread();
+    if (waits)
+    {
+        while ((_lines.size() >= PROCESS_BUFFER_LINES) && (receivers(SIGNAL(outputReady())) > 0))
+        {
+            _drained.wait(&_mutex, PROCESS_POLL_INTERVAL);
+        }
+    }
+    const bool notify = _lines.isEmpty();
+    foreach (const QString &l, lines)
+    {
+        _lines << Line{error, l};
+    }
+    if (!waits && (_lines.size() > PROCESS_BUFFER_LINES))
+    {
+        // The consumer's own thread cannot wait for itself, so the oldest lines go
+        _lines.remove(0, _lines.size() - PROCESS_BUFFER_LINES);
+    }
+    locker.unlock();
+    if (notify)
+    {
+        emit outputReady();
+    }
+}
+
+/**
+ * @brief Token checked by every exec() on the calling thread; jobs set their
+ * own while they run.
+ */
+void Process::setCancelToken(const CancelToken &t)
+{
+    cancelTokens.setLocalData(t);
+}
+
+QVector<Process::Line> Process::take()
+{
+    QMutexLocker locker(&_mutex);
+    QVector<Line> lines;
+    lines.swap(_lines);
+    _drained.wakeAll();
+    return lines;
+}
+
 APP_NAMESPACE_END
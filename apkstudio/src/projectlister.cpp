@@ -0,0 +1,20 @@
+#include <QDir>
+#include "include/projectlister.h"
+
+APP_NAMESPACE_START
+
+ProjectLister::ProjectLister(const int g, const QString &p)
+    : QObject(0), _generation(g), _path(p)
+{
+    setAutoDelete(false);
+}
+
+void ProjectLister::run()
+{
+    const QDir dir(_path);
+    const QStringList dirs = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    const QStringList files = dir.entryList(QDir::Files, QDir::Name);
+    emit listed(_generation, _path, dirs, files);
+}
+
+APP_NAMESPACE_END
@@ -0,0 +1,396 @@
+#include <QFileInfo>
+#include <QThreadPool>
+#include "include/constants.h"
+#include "include/projectdock.h"
+#include "include/projectlister.h"
+#include "include/projectmodel.h"
+#include "include/projectscanner.h"
+
+APP_NAMESPACE_START
+
+ProjectModel::ProjectModel(QObject *parent)
+    : QAbstractItemModel(parent), _generation(0), _root(new Node{QVector<Node *>(), true, true, false, QString(), 0, 0})
+{
+    _timer.setInterval(PROJECT_WATCH_DELAY);
+    _timer.setSingleShot(true);
+    connect(&_timer, &QTimer::timeout, this, &ProjectModel::onTimeout);
+    connect(&_watcher, &QFileSystemWatcher::directoryChanged, this, &ProjectModel::onDirectoryChanged);
+}
+
+/**
+ * @brief Brings the children of a node in line with a fresh listing. Both are
+ * ordered directories first, then by name, so one merge pass finds the rows
+ * to drop and to insert while the rest keep their nodes.
+ */
+void ProjectModel::apply(Node *n, const QStringList &dirs, const QStringList &files)
+{
+    struct Entry
+    {
+        bool dir;
+        QString name;
+    };
+    QVector<Entry> entries;
+    entries.reserve(dirs.size() + files.size());
+    foreach (const QString &name, dirs)
+    {
+        entries << Entry{true, name};
+    }
+    foreach (const QString &name, files)
+    {
+        entries << Entry{false, name};
+    }
+    auto before = [](const bool dir1, const QString &name1, const bool dir2, const QString &name2) {
+        return (dir1 != dir2) ? dir1 : (name1 < name2);
+    };
+    auto renumber = [n](const int from) {
+        for (int i = from; i < n->children.size(); i++)
+        {
+            n->children[i]->row = i;
+        }
+    };
+    const QModelIndex parent = createIndex(n->row, 0, n);
+    int row = 0;
+    int j = 0;
+    while ((row < n->children.size()) || (j < entries.size()))
+    {
+        int end = row;
+        while ((end < n->children.size())
+               && ((j >= entries.size()) || before(n->children.at(end)->dir, n->children.at(end)->name, entries.at(j).dir, entries.at(j).name)))
+        {
+            end++;
+        }
+        if (end > row)
+        {
+            beginRemoveRows(parent, row, end - 1);
+            for (int i = row; i < end; i++)
+            {
+                release(n->children.at(i));
+                delete n->children.at(i);
+            }
+            n->children.remove(row, end - row);
+            renumber(row);
+            endRemoveRows();
+            continue;
+        }
+        int k = j;
+        while ((k < entries.size())
+               && ((row >= n->children.size()) || before(entries.at(k).dir, entries.at(k).name, n->children.at(row)->dir, n->children.at(row)->name)))
+        {
+            k++;
+        }
+        if (k > j)
+        {
+            beginInsertRows(parent, row, row + (k - j) - 1);
+            for (int i = j; i < k; i++)
+            {
+                const Entry &e = entries.at(i);
+                n->children.insert(row + (i - j), new Node{QVector<Node *>(), e.dir, !e.dir, false, e.name, n, 0});
+            }
+            renumber(row);
+            endInsertRows();
+            row += k - j;
+            j = k;
+            continue;
+        }
+        row++;
+        j++;
+    }
+}
+
+bool ProjectModel::canFetchMore(const QModelIndex &parent) const
+{
+    const Node *n = node(parent);
+    return n->dir && !n->listed && !n->listing;
+}
+
+int ProjectModel::columnCount(const QModelIndex &parent) const
+{
+    Q_UNUSED(parent)
+    return 1;
+}
+
+QVariant ProjectModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid())
+    {
+        return QVariant();
+    }
+    const Node *n = node(index);
+    switch (role)
+    {
+    case Qt::DisplayRole:
+        return n->name;
+    case Qt::DecorationRole:
+        return icon(n);
+    case ProjectDock::RolePath:
+        return path(n);
+    case ProjectDock::RoleType:
+        return int(n->dir ? ProjectDock::TypeDir : ProjectDock::TypeFile);
+    default:
+        return QVariant();
+    }
+}
+
+void ProjectModel::fetchMore(const QModelIndex &parent)
+{
+    Node *n = node(parent);
+    if (!n->dir || n->listed || n->listing)
+    {
+        return;
+    }
+    QStringList dirs;
+    QStringList files;
+    if (_snapshot && _snapshot->listing(relative(n), dirs, files))
+    {
+        populate(n, dirs, files);
+    }
+    // Also when taken from the snapshot, which is how that gets validated
+    list(n);
+}
+
+ProjectModel::Node *ProjectModel::find(const QString &p) const
+{
+    if (_root->children.isEmpty() || !((p == _project) || p.startsWith(_project + '/')))
+    {
+        return 0;
+    }
+    Node *n = _root->children.first();
+    foreach (const QString &name, p.mid(_project.size()).split('/', QString::SkipEmptyParts))
+    {
+        Node *child = 0;
+        foreach (Node *c, n->children)
+        {
+            if (c->name == name)
+            {
+                child = c;
+                break;
+            }
+        }
+        if (!child)
+        {
+            return 0;
+        }
+        n = child;
+    }
+    return n;
+}
+
+bool ProjectModel::hasChildren(const QModelIndex &parent) const
+{
+    const Node *n = node(parent);
+    return n->dir && (!n->listed || !n->children.isEmpty());
+}
+
+QIcon ProjectModel::icon(const Node *n) const
+{
+    // Asking the provider per file is what made big trees slow, so ask once per suffix
+    const QString key = n->dir ? QString("/") : QFileInfo(n->name).suffix().toLower();
+    QHash<QString, QIcon>::const_iterator it = _icons.constFind(key);
+    if (it != _icons.constEnd())
+    {
+        return it.value();
+    }
+    const QIcon i = n->dir ? _provider.icon(QFileIconProvider::Folder) : _provider.icon(QFileInfo(path(n)));
+    _icons.insert(key, i);
+    return i;
+}
+
+QModelIndex ProjectModel::index(int row, int column, const QModelIndex &parent) const
+{
+    const Node *n = node(parent);
+    if ((column != 0) || (row < 0) || (row >= n->children.size()))
+    {
+        return QModelIndex();
+    }
+    return createIndex(row, column, n->children.at(row));
+}
+
+void ProjectModel::list(Node *n)
+{
+    const QString p = path(n);
+    n->listing = true;
+    _pending.insert(p, n);
+    ProjectLister *l = new ProjectLister(_generation, p);
+    connect(l, &ProjectLister::listed, this, &ProjectModel::onListed, Qt::QueuedConnection);
+    connect(l, &ProjectLister::listed, l, &ProjectLister::deleteLater, Qt::QueuedConnection);
+    QThreadPool::globalInstance()->start(l);
+}
+
+ProjectModel::Node *ProjectModel::node(const QModelIndex &index) const
+{
+    return index.isValid() ? static_cast<Node *>(index.internalPointer()) : _root;
+}
+
+void ProjectModel::onDirectoryChanged(const QString &p)
+{
+    _changed.insert(p);
+    // Not restarted on every event, so a long burst still shows up in steps
+    if (!_timer.isActive())
+    {
+        _timer.start();
+    }
+}
+
+void ProjectModel::onListed(const int g, const QString &p, const QStringList &dirs, const QStringList &files)
+{
+    Node *n;
+    if ((g != _generation) || !(n = _pending.take(p)))
+    {
+        return;
+    }
+    n->listing = false;
+    populate(n, dirs, files);
+}
+
+void ProjectModel::onTimeout()
+{
+    const QSet<QString> changed = _changed;
+    _changed.clear();
+    foreach (const QString &p, changed)
+    {
+        Node *n = find(p);
+        if (n && n->listing)
+        {
+            // Listed again once the one in flight lands
+            _changed.insert(p);
+        }
+        else if (n && n->dir && n->listed)
+        {
+            list(n);
+        }
+    }
+    if (!_changed.isEmpty())
+    {
+        _timer.start();
+    }
+}
+
+QModelIndex ProjectModel::parent(const QModelIndex &index) const
+{
+    const Node *n = node(index);
+    if (!index.isValid() || (n->parent == _root))
+    {
+        return QModelIndex();
+    }
+    return createIndex(n->parent->row, 0, n->parent);
+}
+
+QString ProjectModel::path(const Node *n) const
+{
+    const QString r = relative(n);
+    return r.isEmpty() ? _project : (_project + '/' + r);
+}
+
+void ProjectModel::populate(Node *n, const QStringList &dirs, const QStringList &files)
+{
+    if (!n->listed)
+    {
+        n->listed = true;
+        _watcher.addPath(path(n));
+        if (dirs.isEmpty() && files.isEmpty())
+        {
+            // Nothing to insert, but the view still has to drop the expand arrow
+            emit layoutAboutToBeChanged();
+            emit layoutChanged();
+            return;
+        }
+    }
+    apply(n, dirs, files);
+}
+
+/**
+ * @brief Re-lists every directory listed so far; only differences reach the view.
+ */
+void ProjectModel::refresh()
+{
+    QVector<Node *> queue;
+    queue << _root->children;
+    while (!queue.isEmpty())
+    {
+        Node *n = queue.takeLast();
+        if (n->dir && n->listed && !n->listing)
+        {
+            list(n);
+            queue << n->children;
+        }
+    }
+}
+
+/**
+ * @brief Forgets a node that is about to go away, and everything under it.
+ */
+void ProjectModel::release(Node *n)
+{
+    if (n->dir && (n->listed || n->listing))
+    {
+        const QString p = path(n);
+        _pending.remove(p);
+        _watcher.removePath(p);
+        foreach (Node *c, n->children)
+        {
+            release(c);
+        }
+    }
+}
+
+QString ProjectModel::relative(const Node *n) const
+{
+    QStringList parts;
+    for (; n->parent != _root; n = n->parent)
+    {
+        parts.prepend(n->name);
+    }
+    return parts.join('/');
+}
+
+int ProjectModel::rowCount(const QModelIndex &parent) const
+{
+    return node(parent)->children.size();
+}
+
+void ProjectModel::setProject(const QString &p)
+{
+    beginResetModel();
+    if (!_watcher.directories().isEmpty())
+    {
+        _watcher.removePaths(_watcher.directories());
+    }
+    qDeleteAll(_root->children);
+    _root->children.clear();
+    _changed.clear();
+    _generation++;
+    _pending.clear();
+    _project = p;
+    if (_scan)
+    {
+        _scan->store(1);
+        _scan.clear();
+    }
+    _snapshot.clear();
+    if (!p.isEmpty())
+    {
+        _root->children << new Node{QVector<Node *>(), true, false, false, QFileInfo(p).fileName(), _root, 0};
+        const QString file = ProjectSnapshot::path(p);
+        QSharedPointer<ProjectSnapshot> snapshot(new ProjectSnapshot);
+        if (snapshot->open(file))
+        {
+            _snapshot = snapshot;
+        }
+        _scan = CancelToken(new QAtomicInt(0));
+        ProjectScanner *s = new ProjectScanner(_scan, p, file, _snapshot);
+        connect(s, &ProjectScanner::finished, s, &ProjectScanner::deleteLater, Qt::QueuedConnection);
+        QThreadPool::globalInstance()->start(s);
+    }
+    endResetModel();
+}
+
+ProjectModel::~ProjectModel()
+{
+    if (_scan)
+    {
+        _scan->store(1);
+    }
+    delete _root;
+}
+
+APP_NAMESPACE_END
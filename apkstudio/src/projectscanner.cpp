@@ -0,0 +1,312 @@
+#include <algorithm>
+#include <cstring>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QSaveFile>
+#include <QThread>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include "include/constants.h"
+#include "include/projectscanner.h"
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+APP_NAMESPACE_START
+
+struct ScanListing
+{
+    QString path;
+    qint64 modified;
+    QStringList dirs;
+    QStringList files;
+};
+
+struct ScanQueue
+{
+    QMutex mutex;
+    QVector<QString> dirs;
+};
+
+/**
+ * @brief Where workers with nothing to take wait until directories are
+ * queued or the walk is over.
+ */
+struct ScanIdle
+{
+    QMutex mutex;
+    quint64 generation;
+    QWaitCondition wake;
+};
+
+#ifdef Q_OS_LINUX
+struct ScanDirent
+{
+    quint64 d_ino;
+    qint64 d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[1];
+};
+#endif
+
+/**
+ * @brief Lists a directory the way QDir does by default: no hidden entries,
+ * and links resolved to what they point at. Nothing is read when the
+ * modification time is the known one.
+ */
+static bool scan(const QString &path, const qint64 known, ScanListing &listing)
+{
+#ifdef Q_OS_LINUX
+    const int fd = ::open(QFile::encodeName(path).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0)
+    {
+        listing.modified = (qint64(st.st_mtim.tv_sec) * 1000) + (st.st_mtim.tv_nsec / 1000000);
+    }
+    if (listing.modified == known)
+    {
+        ::close(fd);
+        return true;
+    }
+    listing.dirs.clear();
+    listing.files.clear();
+    alignas(8) char buffer[32 * 1024];
+    long read;
+    while ((read = syscall(SYS_getdents64, fd, buffer, sizeof(buffer))) > 0)
+    {
+        for (long offset = 0; offset < read; )
+        {
+            const ScanDirent *d = reinterpret_cast<const ScanDirent *>(buffer + offset);
+            offset += d->d_reclen;
+            if (d->d_name[0] == '.')
+            {
+                continue;
+            }
+            unsigned char type = d->d_type;
+            if ((type == DT_LNK) || (type == DT_UNKNOWN))
+            {
+                struct stat target;
+                if (fstatat(fd, d->d_name, &target, 0) != 0)
+                {
+                    continue;
+                }
+                type = S_ISDIR(target.st_mode) ? DT_DIR : (S_ISREG(target.st_mode) ? DT_REG : DT_UNKNOWN);
+            }
+            if (type == DT_DIR)
+            {
+                listing.dirs << QFile::decodeName(d->d_name);
+            }
+            else if (type == DT_REG)
+            {
+                listing.files << QFile::decodeName(d->d_name);
+            }
+        }
+    }
+    ::close(fd);
+#else
+    const QFileInfo info(path);
+    if (!info.isDir())
+    {
+        return false;
+    }
+    listing.modified = info.lastModified().toMSecsSinceEpoch();
+    if (listing.modified == known)
+    {
+        return true;
+    }
+    const QDir dir(path);
+    listing.dirs = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    listing.files = dir.entryList(QDir::Files);
+#endif
+    std::sort(listing.dirs.begin(), listing.dirs.end());
+    std::sort(listing.files.begin(), listing.files.end());
+    return true;
+}
+
+class ScanWorker : public QRunnable
+{
+private:
+    ScanIdle &_idle;
+    int _index;
+    QAtomicInt &_outstanding;
+    const ProjectSnapshot *_previous;
+    QList<ScanQueue *> &_queues;
+    QVector<ScanListing> &_results;
+    QString _root;
+    CancelToken _token;
+public:
+    ScanWorker(const int index, const QString &root, const ProjectSnapshot *previous, QList<ScanQueue *> &queues, ScanIdle &idle, QAtomicInt &outstanding, QVector<ScanListing> &results, const CancelToken &token)
+        : _idle(idle), _index(index), _outstanding(outstanding), _previous(previous), _queues(queues), _results(results), _root(root), _token(token)
+    {
+    }
+    void run()
+    {
+        ScanQueue *own = _queues.at(_index);
+        while (!_token->load())
+        {
+            quint64 seen;
+            {
+                QMutexLocker locker(&_idle.mutex);
+                seen = _idle.generation;
+            }
+            QString relative;
+            bool found = false;
+            {
+                QMutexLocker locker(&own->mutex);
+                if (!own->dirs.isEmpty())
+                {
+                    relative = own->dirs.takeLast();
+                    found = true;
+                }
+            }
+            for (int i = 1; !found && (i < _queues.size()); i++)
+            {
+                ScanQueue *other = _queues.at((_index + i) % _queues.size());
+                QMutexLocker locker(&other->mutex);
+                if (!other->dirs.isEmpty())
+                {
+                    relative = other->dirs.takeFirst();
+                    found = true;
+                }
+            }
+            if (!found)
+            {
+                QMutexLocker locker(&_idle.mutex);
+                if (_outstanding.load() == 0)
+                {
+                    break;
+                }
+                if (_idle.generation == seen)
+                {
+                    // Timed, so a cancelled walk is noticed too
+                    _idle.wake.wait(&_idle.mutex, PROCESS_POLL_INTERVAL);
+                }
+                continue;
+            }
+            ScanListing listing;
+            listing.path = relative;
+            listing.modified = -1;
+            qint64 known = -2;
+            if (!_previous || !_previous->listing(relative, listing.dirs, listing.files, &known))
+            {
+                known = -2;
+            }
+            int children = 0;
+            if (scan(relative.isEmpty() ? _root : (_root + '/' + relative), known, listing))
+            {
+                QMutexLocker locker(&own->mutex);
+                foreach (const QString &d, listing.dirs)
+                {
+                    own->dirs << (relative.isEmpty() ? d : (relative + '/' + d));
+                }
+                children = listing.dirs.size();
+                _results << listing;
+            }
+            // Children are counted in before this one is counted out, so the total only hits zero at the end
+            const int left = _outstanding.fetchAndAddOrdered(children - 1) + children - 1;
+            if ((children > 0) || (left == 0))
+            {
+                QMutexLocker locker(&_idle.mutex);
+                _idle.generation++;
+                _idle.wake.wakeAll();
+            }
+        }
+    }
+};
+
+ProjectScanner::ProjectScanner(const CancelToken &t, const QString &p, const QString &f, const QSharedPointer<ProjectSnapshot> &s)
+    : QObject(0), _file(f), _previous(s), _project(p), _token(t)
+{
+    setAutoDelete(false);
+}
+
+void ProjectScanner::run()
+{
+    const int threads = qMax(1, QThread::idealThreadCount());
+    QList<ScanQueue *> queues;
+    for (int i = 0; i < threads; i++)
+    {
+        queues << new ScanQueue;
+    }
+    queues.first()->dirs << QString();
+    QAtomicInt outstanding(1);
+    ScanIdle idle;
+    idle.generation = 0;
+    QVector<QVector<ScanListing> > results(threads);
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    for (int i = 0; i < threads; i++)
+    {
+        pool.start(new ScanWorker(i, _project, _previous.data(), queues, idle, outstanding, results[i], _token));
+    }
+    pool.waitForDone();
+    qDeleteAll(queues);
+    _previous.clear();
+    if (_token->load())
+    {
+        emit finished(_project);
+        return;
+    }
+    QVector<QPair<QByteArray, const ScanListing *> > order;
+    for (int i = 0; i < results.size(); i++)
+    {
+        for (int j = 0; j < results.at(i).size(); j++)
+        {
+            const ScanListing *l = &results.at(i).at(j);
+            order << qMakePair(l->path.toUtf8(), l);
+        }
+    }
+    std::sort(order.begin(), order.end(), [](const QPair<QByteArray, const ScanListing *> &a, const QPair<QByteArray, const ScanListing *> &b) {
+        return a.first < b.first;
+    });
+    QVector<ProjectSnapshot::Dir> dirs;
+    QVector<ProjectSnapshot::Entry> entries;
+    QByteArray strings;
+    dirs.reserve(order.size());
+    for (int i = 0; i < order.size(); i++)
+    {
+        const ScanListing *l = order.at(i).second;
+        dirs << ProjectSnapshot::Dir{l->modified, quint32(strings.size()), quint32(order.at(i).first.size()), quint32(entries.size()), quint32(l->dirs.size()), quint32(l->files.size()), 0};
+        strings.append(order.at(i).first);
+        foreach (const QString &name, l->dirs + l->files)
+        {
+            const QByteArray bytes = name.toUtf8();
+            entries << ProjectSnapshot::Entry{quint32(strings.size()), quint32(bytes.size())};
+            strings.append(bytes);
+        }
+    }
+    ProjectSnapshot::Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, PROJECT_SNAPSHOT_MAGIC, 4);
+    header.version = PROJECT_SNAPSHOT_VERSION;
+    header.dirs = quint32(dirs.size());
+    header.entries = quint32(entries.size());
+    header.dirsOffset = sizeof(header);
+    header.entriesOffset = header.dirsOffset + (quint64(dirs.size()) * sizeof(ProjectSnapshot::Dir));
+    header.stringsOffset = header.entriesOffset + (quint64(entries.size()) * sizeof(ProjectSnapshot::Entry));
+    header.size = header.stringsOffset + quint64(strings.size());
+    QDir().mkpath(QFileInfo(_file).absolutePath());
+    QSaveFile file(_file);
+    if (file.open(QIODevice::WriteOnly))
+    {
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(dirs.constData()), dirs.size() * sizeof(ProjectSnapshot::Dir));
+        file.write(reinterpret_cast<const char *>(entries.constData()), entries.size() * sizeof(ProjectSnapshot::Entry));
+        file.write(strings);
+        file.commit();
+    }
+    emit finished(_project);
+}
+
+APP_NAMESPACE_END
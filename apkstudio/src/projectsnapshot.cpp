@@ -0,0 +1,130 @@
+#include <QCryptographicHash>
+#include <QDir>
+#include "include/constants.h"
+#include "include/pathutils.h"
+#include "include/preferences.h"
+#include "include/projectsnapshot.h"
+
+APP_NAMESPACE_START
+
+ProjectSnapshot::ProjectSnapshot()
+    : _data(0), _dirs(0), _entries(0), _header(0)
+{
+}
+
+bool ProjectSnapshot::listing(const QString &relative, QStringList &dirs, QStringList &files, qint64 *modified) const
+{
+    if (!_header)
+    {
+        return false;
+    }
+    const QByteArray key = relative.toUtf8();
+    const char *strings = reinterpret_cast<const char *>(_data + _header->stringsOffset);
+    int low = 0;
+    int high = int(_header->dirs) - 1;
+    while (low <= high)
+    {
+        const int middle = (low + high) / 2;
+        const Dir &d = _dirs[middle];
+        const int c = memcmp(strings + d.path, key.constData(), size_t(qMin<quint32>(d.length, quint32(key.size()))));
+        const int order = c ? c : (int(d.length) - key.size());
+        if (order < 0)
+        {
+            low = middle + 1;
+        }
+        else if (order > 0)
+        {
+            high = middle - 1;
+        }
+        else
+        {
+            if ((quint64(d.first) + d.dirs + d.files) > _header->entries)
+            {
+                return false;
+            }
+            dirs.clear();
+            files.clear();
+            dirs.reserve(int(d.dirs));
+            files.reserve(int(d.files));
+            for (quint32 i = 0; i < d.dirs; i++)
+            {
+                const Entry &e = _entries[d.first + i];
+                dirs << string(e.name, e.length);
+            }
+            for (quint32 i = 0; i < d.files; i++)
+            {
+                const Entry &e = _entries[d.first + d.dirs + i];
+                files << string(e.name, e.length);
+            }
+            if (modified)
+            {
+                *modified = d.modified;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ProjectSnapshot::open(const QString &p)
+{
+    _file.setFileName(p);
+    if (!_file.open(QIODevice::ReadOnly) || (_file.size() < qint64(sizeof(Header))))
+    {
+        return false;
+    }
+    const qint64 size = _file.size();
+#ifdef Q_OS_WIN
+    // A mapped file cannot be replaced on Windows, and the scanner replaces it
+    _buffer = _file.readAll();
+    _data = reinterpret_cast<const uchar *>(_buffer.constData());
+    _file.close();
+#else
+    _data = _file.map(0, size);
+#endif
+    const Header *h = reinterpret_cast<const Header *>(_data);
+    if (!_data
+            || (qstrncmp(h->magic, PROJECT_SNAPSHOT_MAGIC, 4) != 0)
+            || (h->version != PROJECT_SNAPSHOT_VERSION)
+            || (h->size != quint64(size))
+            || (h->dirsOffset + (quint64(h->dirs) * sizeof(Dir)) > h->entriesOffset)
+            || (h->entriesOffset + (quint64(h->entries) * sizeof(Entry)) > h->stringsOffset)
+            || (h->stringsOffset > h->size))
+    {
+        _buffer.clear();
+        _data = 0;
+        _file.close();
+        return false;
+    }
+    _header = h;
+    _dirs = reinterpret_cast<const Dir *>(_data + h->dirsOffset);
+    _entries = reinterpret_cast<const Entry *>(_data + h->entriesOffset);
+    return true;
+}
+
+/**
+ * @brief Where the snapshot of a project lives; reads the preferences, so call
+ * it from the GUI thread.
+ */
+QString ProjectSnapshot::path(const QString &project)
+{
+    const QByteArray hash = QCryptographicHash::hash(QDir(project).absolutePath().toUtf8(), QCryptographicHash::Sha1).toHex();
+    const QString dir = PathUtils::combine(Preferences::get()->appPath(), FOLDER_SNAPSHOTS);
+    return PathUtils::combine(dir, QString::fromLatin1(hash) + ".snapshot");
+}
+
+QString ProjectSnapshot::string(const quint32 offset, const quint32 length) const
+{
+    if ((_header->stringsOffset + offset + length) > _header->size)
+    {
+        return QString();
+    }
+    return QString::fromUtf8(reinterpret_cast<const char *>(_data + _header->stringsOffset + offset), int(length));
+}
+
+ProjectSnapshot::~ProjectSnapshot()
+{
+    _file.close();
+}
+
+APP_NAMESPACE_END
@@ -0,0 +1,466 @@
+#include <QDir>
+#include <QFileInfo>
+#include <QtEndian>
+#include "include/axmldecoder.h"
+#include "include/constants.h"
+#include "include/pathutils.h"
+#include "include/resourcetable.h"
+
+APP_NAMESPACE_START
+
+enum TableChunk
+{
+    ChunkStringPool = 0x0001,
+    ChunkTable = 0x0002,
+    ChunkPackage = 0x0200,
+    ChunkType = 0x0201
+};
+
+enum EntryFlag
+{
+    EntryComplex = 0x0001,
+    EntryCompact = 0x0008
+};
+
+enum TypeFlag
+{
+    TypeSparse = 0x01,
+    TypeOffset16 = 0x02
+};
+
+static inline quint16 u16(const uchar *p)
+{
+    return qFromLittleEndian<quint16>(p);
+}
+
+static inline quint32 u32(const uchar *p)
+{
+    return qFromLittleEndian<quint32>(p);
+}
+
+ResourceTable::ResourceTable()
+    : _data(0), _size(0)
+{
+}
+
+/**
+ * @brief Qualifiers of a ResTable_config the way res/ folders spell them,
+ * limited to the ones that commonly tell values apart.
+ */
+QString ResourceTable::config(const uchar *c, const quint32 size)
+{
+    QStringList parts;
+    if (size >= 12)
+    {
+        if (u16(c + 4))
+        {
+            parts << QString("mcc%1").arg(u16(c + 4));
+        }
+        if (c[8] && !(c[8] & 0x80))
+        {
+            parts << QString::fromLatin1(reinterpret_cast<const char *>(c + 8), 2);
+            if (c[10] && !(c[10] & 0x80))
+            {
+                parts << ('r' + QString::fromLatin1(reinterpret_cast<const char *>(c + 10), 2));
+            }
+        }
+    }
+    if (size >= 16)
+    {
+        if (c[12] == 1)
+        {
+            parts << "port";
+        }
+        else if (c[12] == 2)
+        {
+            parts << "land";
+        }
+        switch (u16(c + 14))
+        {
+        case 0:
+            break;
+        case 120:
+            parts << "ldpi";
+            break;
+        case 160:
+            parts << "mdpi";
+            break;
+        case 240:
+            parts << "hdpi";
+            break;
+        case 320:
+            parts << "xhdpi";
+            break;
+        case 480:
+            parts << "xxhdpi";
+            break;
+        case 640:
+            parts << "xxxhdpi";
+            break;
+        case 0xfffe:
+            parts << "anydpi";
+            break;
+        case 0xffff:
+            parts << "nodpi";
+            break;
+        default:
+            parts << QString("%1dpi").arg(u16(c + 14));
+        }
+    }
+    if ((size >= 36) && u16(c + 30))
+    {
+        parts << QString("sw%1dp").arg(u16(c + 30));
+    }
+    if (size >= 36)
+    {
+        if (u16(c + 32))
+        {
+            parts << QString("w%1dp").arg(u16(c + 32));
+        }
+        if (u16(c + 34))
+        {
+            parts << QString("h%1dp").arg(u16(c + 34));
+        }
+    }
+    if (size >= 32)
+    {
+        if ((c[29] & 0x30) == 0x20)
+        {
+            parts << "night";
+        }
+        else if ((c[29] & 0x30) == 0x10)
+        {
+            parts << "notnight";
+        }
+    }
+    if ((size >= 28) && u16(c + 24))
+    {
+        parts << QString("v%1").arg(u16(c + 24));
+    }
+    return parts.isEmpty() ? QString("default") : parts.join('-');
+}
+
+/**
+ * @brief Entry of a type chunk, or nothing when that configuration does not
+ * define it.
+ */
+const uchar *ResourceTable::entry(const quint32 c, const quint32 index) const
+{
+    const uchar *chunk = _data + c;
+    const quint32 length = u32(chunk + 4);
+    const quint16 header = u16(chunk + 2);
+    const quint8 flags = chunk[9];
+    const quint32 count = u32(chunk + 12);
+    const quint32 start = u32(chunk + 16);
+    if ((header > length) || (start > length))
+    {
+        return 0;
+    }
+    const uchar *offsets = chunk + header;
+    quint32 offset = 0xffffffff;
+    if (flags & TypeSparse)
+    {
+        // Pairs of (index, offset / 4) sorted by index
+        quint32 low = 0;
+        quint32 high = qMin(count, (length - header) / 4);
+        while (low < high)
+        {
+            const quint32 mid = (low + high) / 2;
+            const quint16 at = u16(offsets + (mid * 4));
+            if (at == index)
+            {
+                offset = u16(offsets + (mid * 4) + 2) * 4;
+                break;
+            }
+            if (at < index)
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+    }
+    else if (index < count)
+    {
+        if (flags & TypeOffset16)
+        {
+            if ((header + ((index + 1) * 2)) <= length)
+            {
+                const quint16 o = u16(offsets + (index * 2));
+                offset = (o == 0xffff) ? 0xffffffff : (quint32(o) * 4);
+            }
+        }
+        else if ((header + ((index + 1) * 4)) <= length)
+        {
+            offset = u32(offsets + (index * 4));
+        }
+    }
+    if ((offset == 0xffffffff) || ((quint64(start) + offset + 8) > length))
+    {
+        return 0;
+    }
+    return chunk + start + offset;
+}
+
+/**
+ * @brief "@type/key" for the id, prefixed with the package name unless it is
+ * the app's own.
+ */
+QString ResourceTable::name(const quint32 id)
+{
+    Package *p = package(id >> 24);
+    if (!p)
+    {
+        return QString();
+    }
+    const quint32 type = (id >> 16) & 0xff;
+    if ((type == 0) || (int(type) > p->chunks.size()))
+    {
+        return QString();
+    }
+    foreach (const quint32 c, p->chunks.at(int(type - 1)))
+    {
+        const uchar *e = entry(c, id & 0xffff);
+        if (e)
+        {
+            const quint32 key = (u16(e + 2) & EntryCompact) ? u16(e) : u32(e + 4);
+            const QString prefix = (p->id == 0x7f) ? QString() : (p->name + ':');
+            return QString("@%1%2/%3").arg(prefix, p->types.at(type - 1), p->keys.at(key));
+        }
+    }
+    return QString();
+}
+
+bool ResourceTable::open(const QString &p)
+{
+    if (p.endsWith(".apk", Qt::CaseInsensitive))
+    {
+        if (!_zip.open(p))
+        {
+            return false;
+        }
+        const int i = _zip.find("resources.arsc");
+        if (i < 0)
+        {
+            return false;
+        }
+        // Stored as required since Android 11, so usually read in place
+        _data = _zip.data(i);
+        _size = qint64(_zip.entry(i).size);
+        if (!_data)
+        {
+            _buffer = _zip.read(i);
+            _data = reinterpret_cast<const uchar *>(_buffer.constData());
+            _size = _buffer.size();
+        }
+    }
+    else
+    {
+        _file.setFileName(p);
+        if (!_file.open(QIODevice::ReadOnly) || !_file.size())
+        {
+            return false;
+        }
+        _size = _file.size();
+        _data = _file.map(0, _size);
+    }
+    return _data && parse();
+}
+
+/**
+ * @brief First lookup in a package finds its key and type name pools and
+ * notes every type chunk by type id.
+ */
+ResourceTable::Package *ResourceTable::package(const quint32 id)
+{
+    for (int i = 0; i < _packages.size(); i++)
+    {
+        Package &p = _packages[i];
+        if (p.id != id)
+        {
+            continue;
+        }
+        if (!p.indexed)
+        {
+            p.indexed = true;
+            const uchar *chunk = _data + p.offset;
+            const quint32 length = u32(chunk + 4);
+            const quint16 header = u16(chunk + 2);
+            if ((header >= 284) && (header <= length))
+            {
+                for (int c = 0; (c < 128) && u16(chunk + 12 + (c * 2)); c++)
+                {
+                    p.name.append(QChar(u16(chunk + 12 + (c * 2))));
+                }
+                const quint32 types = u32(chunk + 268);
+                const quint32 keys = u32(chunk + 276);
+                if ((types + 8) <= length)
+                {
+                    p.types.read(chunk + types, qMin(u32(chunk + types + 4), length - types));
+                }
+                if ((keys + 8) <= length)
+                {
+                    p.keys.read(chunk + keys, qMin(u32(chunk + keys + 4), length - keys));
+                }
+                for (quint32 at = header; (at + 20) <= length; )
+                {
+                    const uchar *child = chunk + at;
+                    const quint32 size = u32(child + 4);
+                    if ((size < 8) || ((at + size) > length))
+                    {
+                        break;
+                    }
+                    if ((u16(child) == ChunkType) && child[8])
+                    {
+                        if (p.chunks.size() < child[8])
+                        {
+                            p.chunks.resize(child[8]);
+                        }
+                        p.chunks[child[8] - 1] << (p.offset + at);
+                    }
+                    at += size;
+                }
+            }
+        }
+        return &p;
+    }
+    return 0;
+}
+
+bool ResourceTable::parse()
+{
+    if ((_size < 12) || (u16(_data) != ChunkTable))
+    {
+        return false;
+    }
+    const qint64 size = qMin<qint64>(_size, u32(_data + 4));
+    for (qint64 at = u16(_data + 2); (at + 8) <= size; )
+    {
+        const uchar *chunk = _data + at;
+        const quint32 length = u32(chunk + 4);
+        if ((length < 8) || ((at + length) > size))
+        {
+            break;
+        }
+        if (u16(chunk) == ChunkStringPool)
+        {
+            _strings.read(chunk, length);
+        }
+        else if ((u16(chunk) == ChunkPackage) && (length >= 12))
+        {
+            _packages << Package{u32(chunk + 8), quint32(at), false, QString(), StringPool(), StringPool(), QVector<QVector<quint32> >()};
+        }
+        at += length;
+    }
+    return !_packages.isEmpty();
+}
+
+/**
+ * @brief The arsc of the project or APK a file belongs to: next to it or up
+ * its folders, a resources.arsc kept by apktool or built from the project, or
+ * the APK it was decoded or extracted from.
+ */
+QString ResourceTable::sourceFor(const QString &p)
+{
+    QDir dir = QFileInfo(p).absoluteDir();
+    do
+    {
+        QString candidate;
+        if (QFile::exists(candidate = dir.filePath("resources.arsc")))
+        {
+            return candidate;
+        }
+        QFile marker(dir.filePath(FILE_APK_SOURCE));
+        if (marker.open(QIODevice::ReadOnly))
+        {
+            const QString apk = QString::fromUtf8(marker.readAll()).trimmed();
+            if (QFile::exists(apk))
+            {
+                return apk;
+            }
+        }
+        if (QFile::exists(dir.filePath("apktool.yml")))
+        {
+            if (QFile::exists(candidate = dir.filePath("build/apk/resources.arsc")))
+            {
+                return candidate;
+            }
+            return QString();
+        }
+    }
+    while (dir.cdUp());
+    return QString();
+}
+
+/**
+ * @brief One line per configuration that defines the id, e.g.
+ * "de-rDE: Hallo". References are followed by name only.
+ */
+QStringList ResourceTable::values(const quint32 id)
+{
+    QStringList lines;
+    Package *p = package(id >> 24);
+    const quint32 type = (id >> 16) & 0xff;
+    if (!p || (type == 0) || (int(type) > p->chunks.size()))
+    {
+        return lines;
+    }
+    foreach (const quint32 c, p->chunks.at(int(type - 1)))
+    {
+        const uchar *e = entry(c, id & 0xffff);
+        if (e)
+        {
+            const uchar *chunk = _data + c;
+            const quint32 size = qMin<quint32>(u32(chunk + 20), qMax<quint32>(u16(chunk + 2), 20) - 20);
+            lines << QString("%1: %2").arg(config(chunk + 20, size), text(e, chunk + u32(chunk + 4)));
+        }
+        if (lines.size() >= RESOURCE_TOOLTIP_LINES)
+        {
+            lines << "...";
+            break;
+        }
+    }
+    return lines;
+}
+
+QString ResourceTable::text(const uchar *e, const uchar *end)
+{
+    const quint16 flags = u16(e + 2);
+    if (flags & EntryCompact)
+    {
+        return AxmlDecoder::value(quint8(flags >> 8), u32(e + 4), _strings);
+    }
+    if ((e + 16) > end)
+    {
+        return QString();
+    }
+    if (flags & EntryComplex)
+    {
+        return QString("{%1 items}").arg(u32(e + 12));
+    }
+    const uchar *v = e + u16(e);
+    if ((v + 8) > end)
+    {
+        return QString();
+    }
+    const quint8 type = v[3];
+    const quint32 data = u32(v + 4);
+    if ((type == 0x01) && data)
+    {
+        const QString n = name(data);
+        if (!n.isEmpty())
+        {
+            return n;
+        }
+    }
+    QString text = AxmlDecoder::value(type, data, _strings);
+    if (text.size() > RESOURCE_TOOLTIP_CHARS)
+    {
+        text = text.left(RESOURCE_TOOLTIP_CHARS) + "...";
+    }
+    return text;
+}
+
+APP_NAMESPACE_END
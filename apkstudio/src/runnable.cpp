@@ -1,15 +1,23 @@
+#include "include/process.h"
 #include "include/runnable.h"
 
 APP_NAMESPACE_START
 
-Runnable::Runnable(QObject *p)
-    : QObject(p)
+Runnable::Runnable(const QString &t, const QString &r, QObject *p)
+    : QObject(p), _resource(r), _title(t), _token(new QAtomicInt(0))
 {
-    _connections << connect(this, SIGNAL(runnableStarted()), p, SLOT(onRunnableStarted()), Qt::QueuedConnection);
-    _connections << connect(this, SIGNAL(runnableStopped()), p, SLOT(onRunnableStopped()), Qt::QueuedConnection);
     setAutoDelete(false);
 }
 
+void Runnable::run()
+{
+    emit runnableStarted();
+    Process::setCancelToken(_token);
+    const bool success = !isCancelled() && execute() && !isCancelled();
+    Process::setCancelToken(CancelToken());
+    emit runnableStopped(success);
+}
+
 Runnable::~Runnable()
 {
     APP_CONNECTIONS_DISCONNECT
@@ -1,4 +1,5 @@
 #include "include/constants.h"
+#include "include/preferences.h"
 #include "include/runner.h"
 
 APP_NAMESPACE_START
@@ -6,15 +7,62 @@ APP_NAMESPACE_START
 Runner* Runner::_self = NULL;
 
 Runner::Runner(QObject *p)
-    : QObject(p), _pool(new QThreadPool(this))
+    : QObject(p), _last(0), _pool(new QThreadPool(this))
 {
+    // Concurrency is decided per resource in schedule(), the pool only caps the total
     _pool->setMaxThreadCount(THREADS_MAX);
 }
 
-void Runner::add(Runnable *r)
+int Runner::add(Runnable *r, const int a)
 {
-    _connections << connect(r, &Runnable::runnableStopped, r, &Runnable::deleteLater, Qt::QueuedConnection);
-    _pool->start(r);
+    const int id = ++_last;
+    connect(r, &Runnable::runnableStopped, this, &Runner::onRunnableStopped, Qt::QueuedConnection);
+    _ids.insert(r, id);
+    Job j;
+    j.after = _jobs.contains(a) ? a : 0;
+    j.elapsed = 0;
+    j.runnable = r;
+    j.state = Runnable::StateQueued;
+    _jobs.insert(id, j);
+    _queue << id;
+    emit jobAdded(id, r->title());
+    schedule();
+    return id;
+}
+
+void Runner::cancel(const int id)
+{
+    QMap<int, Job>::iterator it = _jobs.find(id);
+    if (it == _jobs.end())
+    {
+        return;
+    }
+    if (it->state == Runnable::StateQueued)
+    {
+        _queue.removeAll(id);
+        _ids.remove(it->runnable);
+        delete it->runnable;
+        it->runnable = 0;
+        setState(id, Runnable::StateCancelled);
+        schedule();
+    }
+    else if (it->state == Runnable::StateRunning)
+    {
+        it->runnable->cancel();
+    }
+}
+
+/**
+ * @brief Milliseconds the job has been running, or ran for once finished.
+ */
+qint64 Runner::elapsed(const int id) const
+{
+    QMap<int, Job>::const_iterator it = _jobs.constFind(id);
+    if (it == _jobs.constEnd())
+    {
+        return 0;
+    }
+    return (it->state == Runnable::StateRunning) ? it->timer.elapsed() : it->elapsed;
 }
 
 Runner *Runner::get()
@@ -26,6 +74,80 @@ Runner *Runner::get()
     return _self;
 }
 
+int Runner::limit(const QString &r) const
+{
+    if (r == RUNNER_RESOURCE_JAVA)
+    {
+        return qMax(1, Preferences::get()->parallelJobs());
+    }
+    return 1;
+}
+
+void Runner::onRunnableStopped(const bool s)
+{
+    Runnable *r = qobject_cast<Runnable *>(sender());
+    if (!r || !_ids.contains(r))
+    {
+        return;
+    }
+    const int id = _ids.take(r);
+    _busy[r->resource()]--;
+    _jobs[id].runnable = 0;
+    r->deleteLater();
+    setState(id, r->isCancelled() ? Runnable::StateCancelled : (s ? Runnable::StateSucceeded : Runnable::StateFailed));
+    schedule();
+}
+
+void Runner::schedule()
+{
+    for (int i = 0; i < _queue.size();)
+    {
+        const int id = _queue.at(i);
+        const Job &j = _jobs[id];
+        const Runnable::State before = j.after ? _jobs[j.after].state : Runnable::StateSucceeded;
+        if ((before == Runnable::StateFailed) || (before == Runnable::StateCancelled))
+        {
+            // A chain stops at its first broken link; jobs only ever come after older ones, so this cascades in one pass
+            _queue.removeAt(i);
+            _ids.remove(j.runnable);
+            delete j.runnable;
+            _jobs[id].runnable = 0;
+            setState(id, Runnable::StateCancelled);
+            continue;
+        }
+        const QString resource = j.runnable->resource();
+        if ((before == Runnable::StateSucceeded) && (_busy.value(resource) < limit(resource)))
+        {
+            _queue.removeAt(i);
+            _busy[resource]++;
+            _pool->start(j.runnable);
+            setState(id, Runnable::StateRunning);
+            continue;
+        }
+        i++;
+    }
+}
+
+void Runner::setState(const int id, const Runnable::State s)
+{
+    Job &j = _jobs[id];
+    if (s == Runnable::StateRunning)
+    {
+        j.timer.start();
+    }
+    else if (j.state == Runnable::StateRunning)
+    {
+        j.elapsed = j.timer.elapsed();
+    }
+    j.state = s;
+    emit jobChanged(id, s);
+}
+
+Runnable::State Runner::state(const int id) const
+{
+    return _jobs.contains(id) ? _jobs[id].state : Runnable::StateCancelled;
+}
+
 Runner::~Runner()
 {
     APP_CONNECTIONS_DISCONNECT
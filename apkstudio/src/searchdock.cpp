@@ -0,0 +1,342 @@
+#include <QDir>
+#include <QFile>
+#include <QHash>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QTextCodec>
+#include <QThreadPool>
+#include <QVBoxLayout>
+#include "include/constants.h"
+#include "include/lineindex.h"
+#include "include/preferences.h"
+#include "include/qrc.h"
+#include "include/searchdock.h"
+#include "include/searchwalker.h"
+#include "include/smaliindexer.h"
+#include "include/trigramindexer.h"
+
+APP_NAMESPACE_START
+
+SearchDock::SearchDock(QWidget *p)
+    : QDockWidget(__("search", "docks"), p), _files(0), _generation(0), _indexing(false), _matches(0), _running(0), _symbolsIndexing(false)
+{
+    _connections << connect(this, SIGNAL(fileOpenAt(QString, int)), p, SLOT(onFileOpenAt(QString, int)));
+    _connections << connect(p, SIGNAL(editFindInFiles()), this, SLOT(onFindInFiles()));
+    _connections << connect(p, SIGNAL(projectOpen(QString)), this, SLOT(onProjectOpen(QString)));
+    _connections << connect(p, SIGNAL(symbolRequested(QString, bool)), this, SLOT(onSymbolRequested(QString, bool)));
+    QWidget *widget = new QWidget(this);
+    QHBoxLayout *options = new QHBoxLayout;
+    QVBoxLayout *layout = new QVBoxLayout(widget);
+    _query = new QLineEdit(widget);
+    _query->setClearButtonEnabled(true);
+    _query->setPlaceholderText(__("search_for", "forms"));
+    options->addWidget(_query, 1);
+    options->addWidget(_caseSensitive = new QCheckBox(__("case_sensitive", "forms"), widget));
+    options->addWidget(_useRegex = new QCheckBox(__("use_regex", "forms"), widget));
+    _tree = new QTreeWidget(widget);
+    _tree->header()->hide();
+    _tree->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    _tree->setSelectionMode(QAbstractItemView::SingleSelection);
+    _tree->setUniformRowHeights(true);
+    _status = new QLabel(widget);
+    layout->addLayout(options);
+    layout->addWidget(_tree, 1);
+    layout->addWidget(_status);
+    layout->setContentsMargins(2, 2, 2, 2);
+    _timer.setInterval(SEARCH_DELAY);
+    _timer.setSingleShot(true);
+    _connections << connect(_query, &QLineEdit::textChanged, &_timer, static_cast<void (QTimer::*)()>(&QTimer::start));
+    _connections << connect(_query, &QLineEdit::returnPressed, this, &SearchDock::onSearch);
+    _connections << connect(_caseSensitive, &QCheckBox::toggled, this, &SearchDock::onSearch);
+    _connections << connect(_useRegex, &QCheckBox::toggled, this, &SearchDock::onSearch);
+    _connections << connect(&_timer, &QTimer::timeout, this, &SearchDock::onSearch);
+    _reindex.setInterval(TRIGRAM_INDEX_DELAY);
+    _reindex.setSingleShot(true);
+    _connections << connect(&_reindex, &QTimer::timeout, this, &SearchDock::onReindex);
+    _connections << connect(_tree, &QTreeWidget::itemActivated, this, &SearchDock::onItemActivated);
+    setObjectName("SearchDock");
+    setWidget(widget);
+}
+
+void SearchDock::cancel()
+{
+    if (_token)
+    {
+        _token->store(1);
+        _token.clear();
+    }
+    _generation++;
+    _running = 0;
+}
+
+void SearchDock::onFilesFound(const int g, const QStringList &f)
+{
+    if ((g != _generation) || !_token)
+    {
+        return;
+    }
+    SearchWorker *w = new SearchWorker(_token, g, _search, f);
+    connect(w, &SearchWorker::matchesFound, this, &SearchDock::onMatchesFound, Qt::QueuedConnection);
+    connect(w, &SearchWorker::finished, this, &SearchDock::onWorkerFinished, Qt::QueuedConnection);
+    connect(w, &SearchWorker::finished, w, &SearchWorker::deleteLater, Qt::QueuedConnection);
+    _running++;
+    QThreadPool::globalInstance()->start(w);
+}
+
+void SearchDock::onFindInFiles()
+{
+    show();
+    raise();
+    _query->setFocus();
+    _query->selectAll();
+}
+
+void SearchDock::onIndexed(const QString &p)
+{
+    if (p != _project)
+    {
+        return;
+    }
+    _indexing = false;
+    QSharedPointer<TrigramIndex> index(new TrigramIndex);
+    if (index->open(p))
+    {
+        _index = index;
+    }
+}
+
+void SearchDock::onIndexStale()
+{
+    if (!_indexing)
+    {
+        _reindex.start();
+    }
+}
+
+void SearchDock::onItemActivated(QTreeWidgetItem *item, const int column)
+{
+    Q_UNUSED(column)
+    const QString path = item->data(0, RolePath).toString();
+    if (!path.isEmpty())
+    {
+        emit fileOpenAt(path, item->data(0, RoleLine).toInt());
+    }
+}
+
+void SearchDock::onMatchesFound(const int g, const QString &path, const SearchMatchList &matches)
+{
+    if ((g != _generation) || !_token)
+    {
+        return;
+    }
+    QTreeWidgetItem *file = new QTreeWidgetItem(_tree);
+    file->setData(0, RoleLine, 0);
+    file->setData(0, RolePath, path);
+    file->setText(0, QString("%1 (%2)").arg(QDir(_project).relativeFilePath(path)).arg(matches.size()));
+    foreach (const SearchMatch &m, matches)
+    {
+        QTreeWidgetItem *child = new QTreeWidgetItem(file);
+        child->setData(0, RoleLine, m.line);
+        child->setData(0, RolePath, path);
+        child->setText(0, QString("%1: %2").arg(m.line + 1).arg(m.preview));
+    }
+    _files++;
+    _matches += matches.size();
+    if (_matches >= SEARCH_MAX_RESULTS)
+    {
+        // Enough to refine the query from, stop burning cores on the rest
+        cancel();
+    }
+    updateStatus();
+}
+
+void SearchDock::onProjectOpen(const QString &p)
+{
+    _project = p;
+    _index.clear();
+    _symbols.clear();
+    if (_indexToken)
+    {
+        _indexToken->store(1);
+    }
+    _indexing = false;
+    _symbolsIndexing = false;
+    onReindex();
+    onSearch();
+}
+
+void SearchDock::onReindex()
+{
+    if ((_indexing && _symbolsIndexing) || !QFile::exists(QDir(_project).filePath("apktool.yml")))
+    {
+        return;
+    }
+    if (!_indexToken || (!_indexing && !_symbolsIndexing))
+    {
+        _indexToken = CancelToken(new QAtomicInt(0));
+    }
+    if (!_indexing)
+    {
+        // Let go of the mapping so the new index can replace the file
+        _index.clear();
+        _indexing = true;
+        TrigramIndexer *i = new TrigramIndexer(_indexToken, _project);
+        connect(i, &TrigramIndexer::finished, this, &SearchDock::onIndexed, Qt::QueuedConnection);
+        connect(i, &TrigramIndexer::finished, i, &TrigramIndexer::deleteLater, Qt::QueuedConnection);
+        QThreadPool::globalInstance()->start(i);
+    }
+    if (!_symbolsIndexing)
+    {
+        _symbolsIndexing = true;
+        SmaliIndexer *s = new SmaliIndexer(_indexToken, _project);
+        connect(s, &SmaliIndexer::finished, this, &SearchDock::onSymbolsIndexed, Qt::QueuedConnection);
+        connect(s, &SmaliIndexer::finished, s, &SmaliIndexer::deleteLater, Qt::QueuedConnection);
+        QThreadPool::globalInstance()->start(s);
+    }
+}
+
+void SearchDock::onSearch()
+{
+    _timer.stop();
+    cancel();
+    _files = 0;
+    _matches = 0;
+    _tree->clear();
+    _search.caseSensitive = _caseSensitive->isChecked();
+    _search.encoding = Preferences::get()->textEncoding();
+    _search.regex = _useRegex->isChecked();
+    _search.text = _query->text();
+    if (!_search.text.isEmpty() && !_project.isEmpty())
+    {
+        // Trigrams are taken from raw bytes, which only works for ASCII based encodings
+        QTextCodec *codec = QTextCodec::codecForMib(_search.encoding);
+        const bool ascii = !codec || (codec->fromUnicode(QStringLiteral("abc")) == "abc");
+        _token = CancelToken(new QAtomicInt(0));
+        SearchWalker *w = new SearchWalker(_token, _generation, _project, _index, ascii ? TrigramIndex::required(_search.text, _search.regex) : QVector<quint32>());
+        connect(w, &SearchWalker::filesFound, this, &SearchDock::onFilesFound, Qt::QueuedConnection);
+        connect(w, &SearchWalker::indexStale, this, &SearchDock::onIndexStale, Qt::QueuedConnection);
+        connect(w, &SearchWalker::finished, this, &SearchDock::onWorkerFinished, Qt::QueuedConnection);
+        connect(w, &SearchWalker::finished, w, &SearchWalker::deleteLater, Qt::QueuedConnection);
+        _running++;
+        QThreadPool::globalInstance()->start(w);
+    }
+    updateStatus();
+}
+
+void SearchDock::onSymbolRequested(const QString &s, const bool u)
+{
+    if (!_symbols)
+    {
+        show();
+        raise();
+        _status->setText(__("symbols_indexing", "messages"));
+        return;
+    }
+    if (u)
+    {
+        const QVector<SmaliIndex::Location> usages = _symbols->usages(s, SEARCH_MAX_RESULTS);
+        showLocations(__("symbol_usages", "messages", QString::number(usages.size()), s), usages);
+        return;
+    }
+    const QVector<SmaliIndex::Location> definitions = _symbols->definitions(s);
+    if (definitions.size() == 1)
+    {
+        emit fileOpenAt(definitions.first().path, definitions.first().line);
+    }
+    else
+    {
+        showLocations(__("symbol_definitions", "messages", QString::number(definitions.size()), s), definitions);
+    }
+}
+
+void SearchDock::onSymbolsIndexed(const QString &p)
+{
+    SmaliIndexer *s = qobject_cast<SmaliIndexer *>(sender());
+    if (s && (p == _project))
+    {
+        _symbolsIndexing = false;
+        if (s->index())
+        {
+            _symbols = s->index();
+        }
+    }
+}
+
+void SearchDock::onWorkerFinished(const int g)
+{
+    if ((g == _generation) && (_running > 0))
+    {
+        _running--;
+        updateStatus();
+    }
+}
+
+void SearchDock::showLocations(const QString &status, const QVector<SmaliIndex::Location> &locations)
+{
+    cancel();
+    _search.text.clear();
+    _tree->clear();
+    QHash<QString, QTreeWidgetItem *> files;
+    QHash<QString, QPair<QByteArray, QVector<qint64> > > contents;
+    foreach (const SmaliIndex::Location &l, locations)
+    {
+        QTreeWidgetItem *file = files.value(l.path);
+        if (!file)
+        {
+            files.insert(l.path, file = new QTreeWidgetItem(_tree));
+            file->setData(0, RoleLine, 0);
+            file->setData(0, RolePath, l.path);
+            QFile f(l.path);
+            QByteArray data;
+            if (f.open(QIODevice::ReadOnly))
+            {
+                data = f.readAll();
+            }
+            contents.insert(l.path, qMakePair(data, LineIndex::build(reinterpret_cast<const uchar *>(data.constData()), data.size())));
+        }
+        const QPair<QByteArray, QVector<qint64> > &content = contents[l.path];
+        QString preview;
+        if (l.line < content.second.size())
+        {
+            const qint64 start = content.second.at(l.line);
+            const qint64 end = ((l.line + 1) < content.second.size()) ? content.second.at(l.line + 1) : content.first.size();
+            preview = QString::fromUtf8(content.first.mid(int(start), int(end - start))).trimmed().left(SEARCH_PREVIEW_CHARS);
+        }
+        QTreeWidgetItem *child = new QTreeWidgetItem(file);
+        child->setData(0, RoleLine, l.line);
+        child->setData(0, RolePath, l.path);
+        child->setText(0, QString("%1: %2").arg(l.line + 1).arg(preview));
+    }
+    for (auto it = files.constBegin(); it != files.constEnd(); ++it)
+    {
+        it.value()->setText(0, QString("%1 (%2)").arg(QDir(_project).relativeFilePath(it.key())).arg(it.value()->childCount()));
+    }
+    _status->setText(status);
+    show();
+    raise();
+}
+
+void SearchDock::updateStatus()
+{
+    if (_search.text.isEmpty())
+    {
+        _status->clear();
+    }
+    else
+    {
+        const QString counts = __("search_results", "messages", QString::number(_matches), QString::number(_files));
+        _status->setText(_running ? __("search_running", "messages", counts) : counts);
+    }
+}
+
+SearchDock::~SearchDock()
+{
+    cancel();
+    if (_indexToken)
+    {
+        _indexToken->store(1);
+    }
+    APP_CONNECTIONS_DISCONNECT
+}
+
+APP_NAMESPACE_END
@@ -0,0 +1,66 @@
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include "include/constants.h"
+#include "include/searchwalker.h"
+
+APP_NAMESPACE_START
+
+SearchWalker::SearchWalker(const CancelToken &t, const int g, const QString &r, const QSharedPointer<TrigramIndex> &i, const QVector<quint32> &tg)
+    : QObject(0), _generation(g), _index(i), _root(r), _token(t), _trigrams(tg)
+{
+    setAutoDelete(false);
+}
+
+void SearchWalker::run()
+{
+    const QStringList extensions = QString(EDITOR_EXT_CODER).split('|');
+    const QDir root(_root);
+    const QBitArray candidates = _index ? _index->match(_trigrams) : QBitArray();
+    bool stale = false;
+    QStringList batch;
+    QDirIterator it(_root, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext() && !_token->load())
+    {
+        const QString path = it.next();
+        const QFileInfo info = it.fileInfo();
+        if (extensions.contains(info.suffix(), Qt::CaseInsensitive))
+        {
+            if (_index)
+            {
+                const int id = _index->find(root.relativeFilePath(path));
+                if ((id >= 0)
+                        && (_index->file(id).modified == info.lastModified().toMSecsSinceEpoch())
+                        && (_index->file(id).size == info.size()))
+                {
+                    if (!candidates.testBit(id))
+                    {
+                        continue;
+                    }
+                }
+                else
+                {
+                    stale = true;
+                }
+            }
+            batch << path;
+            if (batch.size() >= SEARCH_BATCH_FILES)
+            {
+                emit filesFound(_generation, batch);
+                batch.clear();
+            }
+        }
+    }
+    if (!batch.isEmpty() && !_token->load())
+    {
+        emit filesFound(_generation, batch);
+    }
+    if (stale)
+    {
+        emit indexStale();
+    }
+    emit finished(_generation);
+}
+
+APP_NAMESPACE_END
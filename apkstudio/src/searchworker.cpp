@@ -0,0 +1,120 @@
+#include <QByteArrayMatcher>
+#include <QFile>
+#include <QRegularExpression>
+#include <QTextCodec>
+#include "include/constants.h"
+#include "include/lineindex.h"
+#include "include/searchworker.h"
+
+APP_NAMESPACE_START
+
+static QString preview(const QString &line)
+{
+    return line.trimmed().left(SEARCH_PREVIEW_CHARS);
+}
+
+SearchWorker::SearchWorker(const CancelToken &t, const int g, const SearchQuery &q, const QStringList &f)
+    : QObject(0), _files(f), _generation(g), _query(q), _token(t)
+{
+    setAutoDelete(false);
+}
+
+void SearchWorker::run()
+{
+    QTextCodec *codec = QTextCodec::codecForMib(_query.encoding);
+    if (!codec)
+    {
+        codec = QTextCodec::codecForName(PREF_DEFAULT_TEXT_ENCODING);
+    }
+    // Plain case-sensitive text is matched on the raw bytes, everything else needs decoding
+    const bool literal = !_query.regex && _query.caseSensitive;
+    const QByteArray pattern = codec->fromUnicode(_query.text);
+    QByteArrayMatcher matcher(pattern);
+    QRegularExpression regex(_query.regex ? _query.text : QRegularExpression::escape(_query.text),
+                             _query.caseSensitive ? QRegularExpression::NoPatternOption : QRegularExpression::CaseInsensitiveOption);
+    regex.optimize();
+    foreach (const QString &path, _files)
+    {
+        if (_token->load() || (!literal && !regex.isValid()) || pattern.isEmpty())
+        {
+            break;
+        }
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly) || (file.size() <= 0) || (file.size() > INT_MAX))
+        {
+            continue;
+        }
+        const int size = int(file.size());
+        QByteArray buffer;
+        const char *data = reinterpret_cast<const char *>(file.map(0, size));
+        if (!data)
+        {
+            buffer = file.readAll();
+            data = buffer.constData();
+        }
+        SearchMatchList matches;
+        if (literal)
+        {
+            int at = matcher.indexIn(data, size);
+            if (at < 0)
+            {
+                continue;
+            }
+            const QVector<qint64> starts = LineIndex::build(reinterpret_cast<const uchar *>(data), size);
+            int line = 0;
+            while ((at >= 0) && (matches.size() < SEARCH_MAX_FILE_MATCHES))
+            {
+                while (((line + 1) < starts.size()) && (starts.at(line + 1) <= at))
+                {
+                    line++;
+                }
+                const int start = int(starts.at(line));
+                const int end = ((line + 1) < starts.size()) ? int(starts.at(line + 1)) : size;
+                SearchMatch m;
+                m.line = line;
+                m.column = codec->toUnicode(data + start, at - start).size();
+                m.length = _query.text.size();
+                m.preview = preview(codec->toUnicode(data + start, end - start));
+                matches << m;
+                at = matcher.indexIn(data, size, at + pattern.size());
+            }
+        }
+        else
+        {
+            const QString text = codec->toUnicode(data, size);
+            QRegularExpressionMatchIterator it = regex.globalMatch(text);
+            if (!it.hasNext())
+            {
+                continue;
+            }
+            const QVector<int> starts = LineIndex::build(text);
+            int line = 0;
+            while (it.hasNext() && (matches.size() < SEARCH_MAX_FILE_MATCHES))
+            {
+                const QRegularExpressionMatch match = it.next();
+                if (match.capturedLength() == 0)
+                {
+                    continue;
+                }
+                while (((line + 1) < starts.size()) && (starts.at(line + 1) <= match.capturedStart()))
+                {
+                    line++;
+                }
+                const int end = ((line + 1) < starts.size()) ? starts.at(line + 1) : text.size();
+                SearchMatch m;
+                m.line = line;
+                m.column = match.capturedStart() - starts.at(line);
+                m.length = match.capturedLength();
+                m.preview = preview(text.mid(starts.at(line), end - starts.at(line)));
+                matches << m;
+            }
+        }
+        if (!matches.isEmpty() && !_token->load())
+        {
+            emit matchesFound(_generation, path, matches);
+        }
+    }
+    emit finished(_generation);
+}
+
+APP_NAMESPACE_END
@@ -4,6 +4,8 @@
 #include <QIcon>
 #include <QPushButton>
 #include <QTextCodec>
+#include "include/constants.h"
+#include "include/javaworker.h"
 #include "include/qrc.h"
 #include "include/preferences.h"
 #include "include/settingseditor.h"
@@ -14,9 +16,9 @@ SettingsEditor::SettingsEditor(QWidget *p)
     : Dialog(__("settings", "titles"), p)
 {
 #ifdef Q_OS_WIN
-    setFixedSize(480, 192);
-#else
     setFixedSize(480, 240);
+#else
+    setFixedSize(480, 304);
 #endif
     setWindowIcon(Qrc::icon("toolbar_settings"));
     Preferences *pr = Preferences::get();
@@ -32,6 +34,12 @@ SettingsEditor::SettingsEditor(QWidget *p)
     _javaHeap->setMaximum(4096);
     _javaHeap->setSingleStep(4);
     _javaHeap->setValue(pr->javaHeap());
+    form->addRow(__("java_worker", "forms"), _javaWorker = new QCheckBox(this));
+    form->addRow(__("parallel_jobs", "forms"), _parallelJobs = new QSpinBox(this));
+    _parallelJobs->setMinimum(1);
+    _parallelJobs->setMaximum(THREADS_MAX);
+    _parallelJobs->setSingleStep(1);
+    _parallelJobs->setValue(pr->parallelJobs());
     form->addRow(__("show_whitespaces", "forms"), _showWhitespaces = new QCheckBox(this));
     form->addRow(__("tab_stop_width", "forms"), _tabStopWidth = new QSpinBox(this));
     _tabStopWidth->setMinimum(1);
@@ -47,6 +55,12 @@ SettingsEditor::SettingsEditor(QWidget *p)
     }
     _textEncoding->setCurrentIndex(_textEncoding->findData(pr->textEncoding()));
     form->addRow(__("use_spaces_for_tabs", "forms"), _useSpacesForTabs = new QCheckBox(this));
+    form->addRow(__("viewer_threshold", "forms"), _viewerThreshold = new QSpinBox(this));
+    _viewerThreshold->setMinimum(1);
+    _viewerThreshold->setMaximum(4096);
+    _viewerThreshold->setSingleStep(1);
+    _viewerThreshold->setValue(pr->viewerThreshold());
+    _javaWorker->setChecked(pr->javaWorker());
     _showWhitespaces->setChecked(pr->showWhitespaces());
     _useSpacesForTabs->setChecked(pr->useSpacesForTabs());
     // Form : End
@@ -85,11 +99,18 @@ void SettingsEditor::onSaveClicked()
     Preferences::get()
             ->setVendorPath(_vendorPath->text())
             ->setJavaHeap(_javaHeap->value())
+            ->setJavaWorker(_javaWorker->isChecked())
+            ->setParallelJobs(_parallelJobs->value())
             ->setShowWhitespaces(_showWhitespaces->isChecked())
             ->setTabStopWidth(_tabStopWidth->value())
             ->setTextEncoding(_textEncoding->itemData(_textEncoding->currentIndex()).toInt())
             ->setUseSpacesForTabs(_useSpacesForTabs->isChecked())
+            ->setViewerThreshold(_viewerThreshold->value())
             ->save();
+    if (!_javaWorker->isChecked())
+    {
+        JavaWorker::stopAll();
+    }
     Dialog::accept();
 }
 
@@ -1,20 +1,22 @@
 #include <QFile>
+#include <QFileInfo>
+#include "include/constants.h"
 #include "include/uberapksigner.h"
 #include "include/pathutils.h"
+#include "include/qrc.h"
 #include "include/signrunnable.h"
 
 APP_NAMESPACE_START
 
 SignRunnable::SignRunnable(const QString &s, const QString &ks, const QString &ksp, const QString &k, const QString &kp, QObject *p)
-    : Runnable(p), _key(k), _keyPass(kp), _keystore(ks),  _keystorePass(ksp), _src(s)
+    : Runnable(__("sign", "jobs", QFileInfo(s).fileName()), RUNNER_RESOURCE_JAVA, p), _key(k), _keyPass(kp), _keystore(ks),  _keystorePass(ksp), _src(s)
 {
     _connections << connect(this, SIGNAL(signFailure(QString)), p, SLOT(onSignFailure(QString)), Qt::QueuedConnection);
     _connections << connect(this, SIGNAL(signSuccess(QString)), p, SLOT(onSignSuccess(QString)), Qt::QueuedConnection);
 }
 
-void SignRunnable::run()
+bool SignRunnable::execute()
 {
-    emit runnableStarted();
     Process::Result r;
     if(_keystore.isEmpty())
         r = UberApkSigner::get()->signDebug(_src);
@@ -23,12 +25,10 @@ void SignRunnable::run()
     if (r.code == 0)
     {
         emit signSuccess(_src);
+        return true;
     }
-    else
-    {
-        emit signFailure(_src);
-    }
-    emit runnableStopped();
+    emit signFailure(_src);
+    return false;
 }
 
 APP_NAMESPACE_END
@@ -0,0 +1,371 @@
+#include <algorithm>
+#include <QFile>
+#include <QHash>
+#include "include/lineindex.h"
+#include "include/smaliindex.h"
+
+APP_NAMESPACE_START
+
+static inline bool separator(const char c)
+{
+    return (c == ' ') || (c == '\t') || (c == ',') || (c == '{') || (c == '}');
+}
+
+/**
+ * @brief Whole token around the first occurrence of the needle, or nothing.
+ */
+static QByteArray tokenWith(const QByteArray &line, const char *needle)
+{
+    const int i = line.indexOf(needle);
+    if (i < 0)
+    {
+        return QByteArray();
+    }
+    int start = i;
+    int end = i;
+    while ((start > 0) && !separator(line.at(start - 1)))
+    {
+        start--;
+    }
+    while ((end < line.size()) && !separator(line.at(end)))
+    {
+        end++;
+    }
+    return line.mid(start, end - start);
+}
+
+static QByteArray tokenLast(const QByteArray &line)
+{
+    int start = line.size();
+    while ((start > 0) && !separator(line.at(start - 1)))
+    {
+        start--;
+    }
+    return line.mid(start);
+}
+
+SmaliIndex::SmaliIndex()
+{
+}
+
+QVector<SmaliIndex::Location> SmaliIndex::definitions(const QString &symbol) const
+{
+    const QByteArray bytes = symbol.toUtf8();
+    const int id = find(bytes.constData(), bytes.size());
+    return (id < 0) ? QVector<Location>() : locations(_definitions, quint32(id), _definitions.size());
+}
+
+int SmaliIndex::find(const char *data, const int size) const
+{
+    if (_slots.isEmpty())
+    {
+        return -1;
+    }
+    const uint mask = uint(_slots.size() - 1);
+    for (uint i = qHashBits(data, size_t(size)) & mask; ; i = (i + 1) & mask)
+    {
+        const quint32 slot = _slots.at(int(i));
+        if (slot == 0)
+        {
+            return -1;
+        }
+        const char *s = _strings.constData() + _offsets.at(int(slot - 1));
+        if ((qstrncmp(s, data, uint(size)) == 0) && (s[size] == '\0'))
+        {
+            return int(slot - 1);
+        }
+    }
+}
+
+/**
+ * @brief Sorts the entries so lookups are binary searches, and orders symbols
+ * by name so a class can find its members by prefix.
+ */
+void SmaliIndex::finish()
+{
+    auto less = [](const Entry &a, const Entry &b) {
+        if (a.symbol != b.symbol)
+        {
+            return a.symbol < b.symbol;
+        }
+        return (a.file != b.file) ? (a.file < b.file) : (a.line < b.line);
+    };
+    std::sort(_definitions.begin(), _definitions.end(), less);
+    std::sort(_usages.begin(), _usages.end(), less);
+    _sorted.resize(_offsets.size());
+    for (int i = 0; i < _sorted.size(); i++)
+    {
+        _sorted[i] = quint32(i);
+    }
+    const char *strings = _strings.constData();
+    const QVector<quint32> &offsets = _offsets;
+    std::sort(_sorted.begin(), _sorted.end(), [strings, &offsets](const quint32 a, const quint32 b) {
+        return qstrcmp(strings + offsets.at(int(a)), strings + offsets.at(int(b))) < 0;
+    });
+    _definitions.squeeze();
+    _offsets.squeeze();
+    _strings.squeeze();
+    _usages.squeeze();
+}
+
+quint32 SmaliIndex::intern(const char *data, const int size)
+{
+    const int existing = find(data, size);
+    if (existing >= 0)
+    {
+        return quint32(existing);
+    }
+    if (((_offsets.size() + 1) * 2) > _slots.size())
+    {
+        // Keep the table at most half full so probes stay short
+        _slots.fill(0, qMax(1024, _slots.size() * 2));
+        const uint mask = uint(_slots.size() - 1);
+        for (int id = 0; id < _offsets.size(); id++)
+        {
+            const char *s = _strings.constData() + _offsets.at(id);
+            uint i = qHashBits(s, qstrlen(s)) & mask;
+            while (_slots.at(int(i)) != 0)
+            {
+                i = (i + 1) & mask;
+            }
+            _slots[int(i)] = quint32(id + 1);
+        }
+    }
+    const quint32 id = quint32(_offsets.size());
+    _offsets << quint32(_strings.size());
+    _strings.append(data, size);
+    _strings.append('\0');
+    const uint mask = uint(_slots.size() - 1);
+    uint i = qHashBits(data, size_t(size)) & mask;
+    while (_slots.at(int(i)) != 0)
+    {
+        i = (i + 1) & mask;
+    }
+    _slots[int(i)] = id + 1;
+    return id;
+}
+
+QVector<SmaliIndex::Location> SmaliIndex::locations(const QVector<Entry> &entries, const quint32 symbol, const int limit) const
+{
+    QVector<Location> found;
+    const Entry key = {symbol, 0, 0};
+    auto it = std::lower_bound(entries.begin(), entries.end(), key, [](const Entry &a, const Entry &b) { return a.symbol < b.symbol; });
+    for (; (it != entries.end()) && (it->symbol == symbol) && (found.size() < limit); ++it)
+    {
+        found << Location{QString::fromUtf8(string(it->file)), int(it->line)};
+    }
+    return found;
+}
+
+void SmaliIndex::merge(const SmaliIndex &other)
+{
+    QVector<quint32> ids(other._offsets.size());
+    for (int i = 0; i < ids.size(); i++)
+    {
+        const char *s = other._strings.constData() + other._offsets.at(i);
+        ids[i] = intern(s, int(qstrlen(s)));
+    }
+    _definitions.reserve(_definitions.size() + other._definitions.size());
+    foreach (const Entry &e, other._definitions)
+    {
+        _definitions << Entry{ids.at(int(e.symbol)), ids.at(int(e.file)), e.line};
+    }
+    _usages.reserve(_usages.size() + other._usages.size());
+    foreach (const Entry &e, other._usages)
+    {
+        _usages << Entry{ids.at(int(e.symbol)), ids.at(int(e.file)), e.line};
+    }
+}
+
+void SmaliIndex::parse(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+    QByteArray buffer;
+    const uchar *data = file.size() ? file.map(0, file.size()) : 0;
+    qint64 size = file.size();
+    if (!data)
+    {
+        buffer = file.readAll();
+        data = reinterpret_cast<const uchar *>(buffer.constData());
+        size = buffer.size();
+    }
+    const QByteArray name = path.toUtf8();
+    const quint32 f = intern(name.constData(), name.size());
+    const QVector<qint64> starts = LineIndex::build(data, size);
+    QByteArray owner;
+    for (int n = 0; n < starts.size(); n++)
+    {
+        qint64 begin = starts.at(n);
+        qint64 end = ((n + 1) < starts.size()) ? (starts.at(n + 1) - 1) : size;
+        while ((begin < end) && ((data[begin] == ' ') || (data[begin] == '\t')))
+        {
+            begin++;
+        }
+        while ((end > begin) && ((data[end - 1] == '\r') || (data[end - 1] == '\n')))
+        {
+            end--;
+        }
+        if (begin >= end)
+        {
+            continue;
+        }
+        const QByteArray line = QByteArray::fromRawData(reinterpret_cast<const char *>(data + begin), int(end - begin));
+        QByteArray symbol;
+        bool definition = false;
+        if (line.startsWith(".class "))
+        {
+            owner = tokenLast(line);
+            symbol = owner;
+            definition = true;
+        }
+        else if (line.startsWith(".field ") && !owner.isEmpty())
+        {
+            symbol = owner + "->" + tokenWith(line, ":");
+            definition = true;
+        }
+        else if (line.startsWith(".method ") && !owner.isEmpty())
+        {
+            symbol = owner + "->" + tokenLast(line);
+            definition = true;
+        }
+        else if (line.startsWith("invoke-")
+                 || line.startsWith("iget") || line.startsWith("iput")
+                 || line.startsWith("sget") || line.startsWith("sput"))
+        {
+            symbol = tokenWith(line, "->");
+        }
+        else if (line.startsWith(".super ") || line.startsWith(".implements ")
+                 || line.startsWith("new-instance ") || line.startsWith("new-array ")
+                 || line.startsWith("check-cast ") || line.startsWith("const-class ")
+                 || line.startsWith("instance-of ") || line.startsWith("filled-new-array"))
+        {
+            symbol = tokenLast(line);
+            while (symbol.startsWith('['))
+            {
+                symbol.remove(0, 1);
+            }
+            if (!symbol.startsWith('L'))
+            {
+                symbol.clear();
+            }
+        }
+        if (!symbol.isEmpty())
+        {
+            const Entry e = {intern(symbol.constData(), symbol.size()), f, quint32(n)};
+            if (definition)
+            {
+                _definitions << e;
+            }
+            else
+            {
+                _usages << e;
+            }
+        }
+    }
+}
+
+QByteArray SmaliIndex::string(const quint32 id) const
+{
+    return QByteArray(_strings.constData() + _offsets.at(int(id)));
+}
+
+/**
+ * @brief Smali reference under the cursor: a class when it sits on one, else
+ * the member being called, accessed or, on its own line, declared.
+ */
+QString SmaliIndex::symbolAt(const QString &line, const int column, const QString &owner)
+{
+    const QByteArray bytes = line.left(column).toUtf8();
+    const QByteArray whole = line.toUtf8();
+    const int at = bytes.size();
+    int start = at;
+    int end = at;
+    while ((start > 0) && !separator(whole.at(start - 1)))
+    {
+        start--;
+    }
+    while ((end < whole.size()) && !separator(whole.at(end)))
+    {
+        end++;
+    }
+    if (start >= end)
+    {
+        return QString();
+    }
+    const QByteArray token = whole.mid(start, end - start);
+    const int offset = at - start;
+    for (int i = 0; i < token.size(); i++)
+    {
+        if ((token.at(i) == 'L') && ((i == 0) || QByteArray("[(;):").contains(token.at(i - 1))))
+        {
+            const int semicolon = token.indexOf(';', i);
+            if (semicolon < 0)
+            {
+                break;
+            }
+            const QByteArray type = token.mid(i, semicolon - i + 1);
+            if ((type.indexOf('(') < 0) && (type.indexOf(')') < 0) && (type.indexOf(':') < 0) && (type.indexOf('>') < 0))
+            {
+                if ((offset >= i) && (offset <= semicolon))
+                {
+                    return QString::fromUtf8(type);
+                }
+                i = semicolon;
+            }
+        }
+    }
+    if (token.contains("->"))
+    {
+        int first = 0;
+        while ((first < token.size()) && (token.at(first) == '['))
+        {
+            first++;
+        }
+        return QString::fromUtf8(token.mid(first));
+    }
+    const QString trimmed = line.trimmed();
+    if (!owner.isEmpty() && ((trimmed.startsWith(".method ") && token.contains('(')) || (trimmed.startsWith(".field ") && token.contains(':'))))
+    {
+        return owner + "->" + QString::fromUtf8(token);
+    }
+    return QString();
+}
+
+/**
+ * @brief Where the symbol is referred to; for a class that includes every use
+ * of its members.
+ */
+QVector<SmaliIndex::Location> SmaliIndex::usages(const QString &symbol, const int limit) const
+{
+    QVector<Location> found;
+    const QByteArray bytes = symbol.toUtf8();
+    const int id = find(bytes.constData(), bytes.size());
+    if (id >= 0)
+    {
+        found = locations(_usages, quint32(id), limit);
+    }
+    if (bytes.endsWith(';') && !bytes.contains("->"))
+    {
+        const QByteArray prefix = bytes + "->";
+        const char *strings = _strings.constData();
+        const QVector<quint32> &offsets = _offsets;
+        auto it = std::lower_bound(_sorted.begin(), _sorted.end(), prefix, [strings, &offsets](const quint32 a, const QByteArray &b) {
+            return qstrcmp(strings + offsets.at(int(a)), b.constData()) < 0;
+        });
+        for (; (it != _sorted.end()) && (found.size() < limit); ++it)
+        {
+            if (qstrncmp(strings + offsets.at(int(*it)), prefix.constData(), uint(prefix.size())) != 0)
+            {
+                break;
+            }
+            found += locations(_usages, *it, limit - found.size());
+        }
+    }
+    return found;
+}
+
+APP_NAMESPACE_END
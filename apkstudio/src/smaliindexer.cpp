@@ -0,0 +1,71 @@
+#include <QDirIterator>
+#include <QThread>
+#include <QThreadPool>
+#include "include/smaliindexer.h"
+
+APP_NAMESPACE_START
+
+/**
+ * @brief Takes files off the shared list until it runs dry.
+ */
+class SmaliParser : public QRunnable
+{
+private:
+    const QStringList &_files;
+    SmaliIndex &_index;
+    QAtomicInt &_next;
+    CancelToken _token;
+public:
+    SmaliParser(const QStringList &files, QAtomicInt &next, SmaliIndex &index, const CancelToken &token)
+        : _files(files), _index(index), _next(next), _token(token)
+    {
+    }
+    void run()
+    {
+        int i;
+        while (((i = _next.fetchAndAddRelaxed(1)) < _files.size()) && !_token->load())
+        {
+            _index.parse(_files.at(i));
+        }
+    }
+};
+
+SmaliIndexer::SmaliIndexer(const CancelToken &t, const QString &p)
+    : QObject(0), _project(p), _token(t)
+{
+    setAutoDelete(false);
+}
+
+void SmaliIndexer::run()
+{
+    QStringList files;
+    QDirIterator it(_project, QStringList() << "*.smali", QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext() && !_token->load())
+    {
+        files << it.next();
+    }
+    const int threads = qMax(1, qMin(QThread::idealThreadCount(), (files.size() / 64) + 1));
+    QVector<SmaliIndex> partials(threads);
+    QAtomicInt next(0);
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    for (int i = 0; i < threads; i++)
+    {
+        pool.start(new SmaliParser(files, next, partials[i], _token));
+    }
+    pool.waitForDone();
+    if (!_token->load())
+    {
+        QSharedPointer<SmaliIndex> index(new SmaliIndex);
+        for (int i = 0; i < partials.size(); i++)
+        {
+            index->merge(partials.at(i));
+            partials[i] = SmaliIndex();
+        }
+        index->finish();
+        _index = index;
+    }
+    emit finished(_project);
+}
+
+APP_NAMESPACE_END
@@ -1,70 +1,168 @@
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QSettings>
+#include <QThreadPool>
 #include "include/adb.h"
 #include "include/apktool.h"
 #include "include/uberapksigner.h"
+#include "include/constants.h"
 #include "include/java.h"
+#include "include/pathutils.h"
+#include "include/preferences.h"
+#include "include/runner.h"
 #include "include/statusbar.h"
 #include "include/qrc.h"
+#include "include/versionprobe.h"
 
 APP_NAMESPACE_START
 
+static const char *versionKeys[] = {"version_adb", "version_apktool", "version_java", "version_uberapksigner"};
+
+/**
+ * @brief Cache group of a binary; it only matches while the file is the same
+ * size and age as when its version was probed.
+ */
+static QString versionGroup(const QString &path)
+{
+    const QFileInfo info(path);
+    if (!info.exists())
+    {
+        return QString();
+    }
+    const QString key = QString("%1|%2|%3").arg(info.absoluteFilePath()).arg(info.size()).arg(info.lastModified().toMSecsSinceEpoch());
+    return QString::fromLatin1(QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex());
+}
+
 StatusBar::StatusBar(QWidget *parent)
-    : QStatusBar(parent)
+    : QStatusBar(parent), _finished(0)
 {
-    QLabel *adb;
-    QLabel *apkTool;
-    QLabel *uberApkSigner;
-    QLabel *java;
-    addPermanentWidget(java = new QLabel(this));
+    addPermanentWidget(_versions[ToolJava] = new QLabel(this));
     addPermanentWidget(new StatusBarSeparator(this));
-    addPermanentWidget(adb = new QLabel(this));
+    addPermanentWidget(_versions[ToolAdb] = new QLabel(this));
     addPermanentWidget(new StatusBarSeparator(this));
-    addPermanentWidget(apkTool = new QLabel(this));
+    addPermanentWidget(_versions[ToolApkTool] = new QLabel(this));
     addPermanentWidget(new StatusBarSeparator(this));
-    addPermanentWidget(uberApkSigner = new QLabel(this));
+    addPermanentWidget(_versions[ToolUberApkSigner] = new QLabel(this));
     addPermanentWidget(new QWidget(this), 1);
     addPermanentWidget(_message = new QLabel(this));
+    addPermanentWidget(_jobs = new QLabel(this));
+    addPermanentWidget(_progress = new QProgressBar(this));
+    _jobs->hide();
+    _progress->setMaximumWidth(120);
+    _progress->setTextVisible(false);
+    _progress->hide();
     setContentsMargins(4, 0, 4, 0);
     setStyleSheet("QStatusBar::item { border: none; }");
-    QString v;
-    if ((v = Adb::get()->getVersion()).isEmpty() == false)
-    {
-        adb->setText(__("version_adb", "statusbar", v));
-    }
-    else
+    _paths[ToolAdb] = Adb::get()->path();
+    _paths[ToolApkTool] = ApkTool::get()->path();
+    _paths[ToolJava] = Java::get()->path();
+    _paths[ToolUberApkSigner] = UberApkSigner::get()->path();
+    probe(ToolAdb, []() { return Adb::get()->getVersion(); });
+    probe(ToolApkTool, []() { return ApkTool::get()->getVersion(); });
+    probe(ToolJava, []() { return Java::get()->getVersion(); });
+    probe(ToolUberApkSigner, []() { return UberApkSigner::get()->getVersion(); });
+    _connections << connect(this, &QStatusBar::messageChanged, this, &StatusBar::onMessageChanged);
+    _connections << connect(Runner::get(), &Runner::jobAdded, this, &StatusBar::onJobAdded);
+    _connections << connect(Runner::get(), &Runner::jobChanged, this, &StatusBar::onJobChanged);
+    _message->setText(__("ready", "statusbar"));
+}
+
+void StatusBar::onJobAdded(const int id)
+{
+    _active.insert(id, Runnable::StateQueued);
+    updateJobs();
+}
+
+void StatusBar::onJobChanged(const int id, const int s)
+{
+    if (!_active.contains(id))
     {
-        adb->setText(__("version_adb", "statusbar", "n/a"));
+        return;
     }
-    if ((v = ApkTool::get()->getVersion()).isEmpty() == false)
+    if ((s == Runnable::StateQueued) || (s == Runnable::StateRunning))
     {
-        apkTool->setText(__("version_apktool", "statusbar", v));
+        _active[id] = s;
     }
     else
     {
-        apkTool->setText(__("version_apktool", "statusbar", "n/a"));
+        _active.remove(id);
+        _finished++;
     }
-    if ((v = UberApkSigner::get()->getVersion()).isEmpty() == false)
+    updateJobs();
+}
+
+void StatusBar::onMessageChanged(const QString &text)
+{
+    _message->setText(text);
+}
+
+void StatusBar::onProbed(const int t, const QString &v)
+{
+    showVersion(t, v);
+    const QString group = versionGroup(_paths[t]);
+    if (!group.isEmpty() && !v.isEmpty())
     {
-        uberApkSigner->setText(__("version_uberapksigner", "statusbar", v));
+        QSettings cache(PathUtils::combine(Preferences::get()->appPath(), FILE_VERSIONS), QSettings::IniFormat);
+        cache.setValue(group + "/path", _paths[t]);
+        cache.setValue(group + "/version", v);
     }
-    else
+}
+
+/**
+ * @brief Shows the cached version of the tool if its binary is unchanged,
+ * else asks the tool in the background.
+ */
+void StatusBar::probe(const int t, const std::function<QString()> &p)
+{
+    const QString group = versionGroup(_paths[t]);
+    if (!group.isEmpty())
     {
-        uberApkSigner->setText(__("version_uberapksigner", "statusbar", "n/a"));
+        QSettings cache(PathUtils::combine(Preferences::get()->appPath(), FILE_VERSIONS), QSettings::IniFormat);
+        const QString v = cache.value(group + "/version").toString();
+        if (!v.isEmpty())
+        {
+            showVersion(t, v);
+            return;
+        }
     }
-    if ((v = Java::get()->getVersion()).isEmpty() == false)
+    _versions[t]->setText(__(versionKeys[t], "statusbar", "..."));
+    VersionProbe *probe = new VersionProbe(t, p);
+    connect(probe, &VersionProbe::probed, this, &StatusBar::onProbed, Qt::QueuedConnection);
+    connect(probe, &VersionProbe::probed, probe, &VersionProbe::deleteLater, Qt::QueuedConnection);
+    QThreadPool::globalInstance()->start(probe);
+}
+
+void StatusBar::showVersion(const int t, const QString &v)
+{
+    _versions[t]->setText(__(versionKeys[t], "statusbar", v.isEmpty() ? QString("n/a") : v));
+}
+
+/**
+ * @brief Progress counts jobs finished since the queue was last empty.
+ */
+void StatusBar::updateJobs()
+{
+    if (_active.isEmpty())
     {
-        java->setText(__("version_java", "statusbar", v));
+        _finished = 0;
+        _jobs->hide();
+        _progress->hide();
+        return;
     }
-    else
+    int running = 0;
+    foreach (const int s, _active)
     {
-        java->setText(__("version_java", "statusbar", "n/a"));
+        if (s == Runnable::StateRunning)
+        {
+            running++;
+        }
     }
-    _connections << connect(this, &QStatusBar::messageChanged, this, &StatusBar::onMessageChanged);
-    _message->setText(__("ready", "statusbar"));
-}
-
-void StatusBar::onMessageChanged(const QString &text)
-{
-    _message->setText(text);
+    _jobs->setText(__("jobs", "statusbar", QString::number(running), QString::number(_active.size() - running)));
+    _jobs->show();
+    _progress->setRange(0, _finished + _active.size());
+    _progress->setValue(_finished);
+    _progress->show();
 }
 
 StatusBar::~StatusBar()
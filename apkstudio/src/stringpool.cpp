@@ -0,0 +1,77 @@
+#include <QtEndian>
+#include "include/stringpool.h"
+
+APP_NAMESPACE_START
+
+StringPool::StringPool()
+    : _count(0), _offsets(0), _size(0), _strings(0), _utf8(false)
+{
+}
+
+QString StringPool::at(const quint32 i) const
+{
+    if (i >= quint32(_count))
+    {
+        return QString();
+    }
+    const quint32 offset = qFromLittleEndian<quint32>(_offsets + (i * 4));
+    if (qint64(offset) >= _size)
+    {
+        return QString();
+    }
+    const uchar *p = _strings + offset;
+    const uchar *end = _strings + _size;
+    if (_utf8)
+    {
+        // Length in characters then in bytes, each one or two bytes long
+        p += (p[0] & 0x80) ? 2 : 1;
+        if ((p + 2) > end)
+        {
+            return QString();
+        }
+        int length = p[0];
+        if (length & 0x80)
+        {
+            length = ((length & 0x7f) << 8) | p[1];
+            p++;
+        }
+        p++;
+        return QString::fromUtf8(reinterpret_cast<const char *>(p), int(qMin<qint64>(length, end - p)));
+    }
+    if ((p + 4) > end)
+    {
+        return QString();
+    }
+    int length = qFromLittleEndian<quint16>(p);
+    p += 2;
+    if (length & 0x8000)
+    {
+        length = ((length & 0x7fff) << 16) | qFromLittleEndian<quint16>(p);
+        p += 2;
+    }
+    length = int(qMin<qint64>(length, (end - p) / 2));
+    QString s(length, Qt::Uninitialized);
+    for (int c = 0; c < length; c++)
+    {
+        s[c] = QChar(qFromLittleEndian<quint16>(p + (c * 2)));
+    }
+    return s;
+}
+
+bool StringPool::read(const uchar *chunk, const quint32 length)
+{
+    const quint16 header = qFromLittleEndian<quint16>(chunk + 2);
+    if ((length < 28) || (header < 28) || (header > length))
+    {
+        return false;
+    }
+    const quint32 start = qMin(qFromLittleEndian<quint32>(chunk + 20), length);
+    _count = int(qMin<quint32>(qFromLittleEndian<quint32>(chunk + 8), (length - header) / 4));
+    _offsets = chunk + header;
+    _strings = chunk + start;
+    _size = length - start;
+    _utf8 = (qFromLittleEndian<quint32>(chunk + 16) & (1 << 8)) != 0;
+    return true;
+}
+
+APP_NAMESPACE_END
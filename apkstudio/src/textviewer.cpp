@@ -0,0 +1,302 @@
+#include <QApplication>
+#include <QClipboard>
+#include <QKeyEvent>
+#include <QPainter>
+#include <QScrollBar>
+#include <QTextLayout>
+#include <QTimer>
+#include "include/constants.h"
+#include "include/lineindex.h"
+#include "include/preferences.h"
+#include "include/textviewer.h"
+
+APP_NAMESPACE_START
+
+TextViewer::TextViewer(QWidget *parent)
+    : QAbstractScrollArea(parent), _codec(0), _current(0), _data(0), _guessed(false), _tokenizer(0), _width(0)
+{
+    QFont f("Source Code Pro");
+    f.setFixedPitch(true);
+    f.setPointSize(10);
+    f.setStyleHint(QFont::Monospace);
+    setFont(f);
+    setFrameStyle(QFrame::NoFrame);
+    _option.setTabStop(Preferences::get()->tabStopWidth() * fontMetrics().width('8'));
+    _option.setWrapMode(QTextOption::NoWrap);
+    if (Preferences::get()->showWhitespaces())
+    {
+        _option.setFlags(QTextOption::ShowTabsAndSpaces);
+    }
+    viewport()->setCursor(Qt::IBeamCursor);
+}
+
+void TextViewer::copy()
+{
+    if (_current < rowCount())
+    {
+        QApplication::clipboard()->setText(line(_current));
+    }
+}
+
+int TextViewer::gutterWidth() const
+{
+    return fontMetrics().width(QString::number(rowCount()).append("  "));
+}
+
+void TextViewer::keyPressEvent(QKeyEvent *e)
+{
+    const int page = qMax(viewport()->height() / fontMetrics().height(), 1);
+    if (e->matches(QKeySequence::Copy))
+    {
+        copy();
+    }
+    else if (e->key() == Qt::Key_Up)
+    {
+        setCurrentRow(_current - 1);
+    }
+    else if (e->key() == Qt::Key_Down)
+    {
+        setCurrentRow(_current + 1);
+    }
+    else if (e->key() == Qt::Key_PageUp)
+    {
+        setCurrentRow(_current - page);
+    }
+    else if (e->key() == Qt::Key_PageDown)
+    {
+        setCurrentRow(_current + page);
+    }
+    else if (e->matches(QKeySequence::MoveToStartOfDocument))
+    {
+        setCurrentRow(0);
+    }
+    else if (e->matches(QKeySequence::MoveToEndOfDocument))
+    {
+        setCurrentRow(rowCount() - 1);
+    }
+    else
+    {
+        QAbstractScrollArea::keyPressEvent(e);
+    }
+}
+
+QString TextViewer::line(const int r) const
+{
+    const qint64 start = _lines.at(r);
+    qint64 end = ((r + 1) < _lines.size()) ? (_lines.at(r + 1) - 1) : _file.size();
+    if ((end > start) && (_data[end - 1] == '\r'))
+    {
+        end--;
+    }
+    const int length = int(qMin<qint64>(end - start, VIEWER_LINE_BYTES));
+    return _codec->toUnicode(reinterpret_cast<const char *>(_data + start), length);
+}
+
+void TextViewer::mousePressEvent(QMouseEvent *e)
+{
+    if (e->button() == Qt::LeftButton)
+    {
+        setCurrentRow(verticalScrollBar()->value() + (e->pos().y() / fontMetrics().height()));
+    }
+    QAbstractScrollArea::mousePressEvent(e);
+}
+
+void TextViewer::onCheckpoint()
+{
+    const int first = (_checkpoints.size() - 1) * HIGHLIGHTER_CHECKPOINT_BLOCKS;
+    const int last = first + HIGHLIGHTER_CHECKPOINT_BLOCKS;
+    if (last >= rowCount())
+    {
+        return;
+    }
+    int state = _checkpoints.last();
+    CoderTokenList tokens;
+    for (int i = first; i < last; i++)
+    {
+        tokens.resize(0);
+        state = _tokenizer->tokenize(line(i), state, tokens);
+    }
+    _checkpoints << state;
+    if (_guessed && ((verticalScrollBar()->value() / HIGHLIGHTER_CHECKPOINT_BLOCKS) < _checkpoints.size()))
+    {
+        viewport()->update();
+    }
+    QTimer::singleShot(0, this, SLOT(onCheckpoint()));
+}
+
+bool TextViewer::open(const QString &p, const QString &d)
+{
+    _file.setFileName(p);
+    if (!_file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+    const qint64 size = _file.size();
+    if ((size > 0) && !(_data = _file.map(0, size)))
+    {
+        _file.close();
+        return false;
+    }
+    _codec = QTextCodec::codecForMib(Preferences::get()->textEncoding());
+    if (!_codec)
+    {
+        _codec = QTextCodec::codecForName(PREF_DEFAULT_TEXT_ENCODING);
+    }
+    _lines = LineIndex::build(_data, size);
+    _tokenizer = CoderTokenizer::get(d, HIGHLIGHTER_THEME);
+    _checkpoints << 0;
+    _states.clear();
+    QTimer::singleShot(0, this, SLOT(onCheckpoint()));
+    updateScrollBars();
+    return true;
+}
+
+void TextViewer::paintEvent(QPaintEvent *e)
+{
+    QPainter p(viewport());
+    p.fillRect(e->rect(), palette().color(QPalette::Base));
+    if (!_tokenizer)
+    {
+        return;
+    }
+    const int height = fontMetrics().height();
+    const int gutter = gutterWidth();
+    const int first = verticalScrollBar()->value();
+    const int last = qMin(first + (viewport()->height() / height) + 1, rowCount());
+    const qreal x = gutter - horizontalScrollBar()->value();
+    const CoderHighlighterDefinitionEntryList &entries = _tokenizer->definition()->entries();
+    int state = stateAt(first, _guessed);
+    int widest = _width;
+    CoderTokenList tokens;
+    for (int i = first; i < last; i++)
+    {
+        const QString text = line(i);
+        const int top = (i - first) * height;
+        tokens.resize(0);
+        state = _tokenizer->tokenize(text, state, tokens);
+        QVector<QTextLayout::FormatRange> formats;
+        formats.reserve(tokens.size());
+        foreach (const CoderToken &token, tokens)
+        {
+            QTextLayout::FormatRange range;
+            range.format = entries.at(token.entry).format;
+            range.length = token.length;
+            range.start = token.start;
+            formats << range;
+        }
+        QTextLayout layout(text, font());
+        layout.setFormats(formats);
+        layout.setTextOption(_option);
+        layout.beginLayout();
+        layout.createLine();
+        layout.endLayout();
+        if (i == _current)
+        {
+            QColor h = palette().color(QPalette::Text);
+            h.setAlpha(25);
+            p.fillRect(0, top, viewport()->width(), height, h);
+        }
+        layout.draw(&p, QPointF(x, top));
+        widest = qMax(widest, int(layout.maximumWidth()));
+    }
+    p.fillRect(0, 0, gutter, viewport()->height(), palette().color(QPalette::Base));
+    p.setPen(palette().color(QPalette::Text));
+    for (int i = first; i < last; i++)
+    {
+        p.drawText(0, (i - first) * height, gutter, height, Qt::AlignRight, QString::number(i + 1).append(' '));
+    }
+    p.setPen(palette().color(QPalette::Highlight));
+    p.drawLine(gutter - 1, 0, gutter - 1, viewport()->height());
+    if (widest != _width)
+    {
+        // Width is only known for lines seen so far, the scroll range grows as they are
+        _width = widest;
+        updateScrollBars();
+    }
+}
+
+void TextViewer::resizeEvent(QResizeEvent *e)
+{
+    QAbstractScrollArea::resizeEvent(e);
+    updateScrollBars();
+}
+
+void TextViewer::setCurrentRow(const int r)
+{
+    _current = qBound(0, r, qMax(rowCount() - 1, 0));
+    const int page = qMax(viewport()->height() / fontMetrics().height(), 1);
+    QScrollBar *vbar = verticalScrollBar();
+    if (_current < vbar->value())
+    {
+        vbar->setValue(_current);
+    }
+    else if (_current >= (vbar->value() + page))
+    {
+        vbar->setValue(_current - page + 1);
+    }
+    viewport()->update();
+}
+
+/**
+ * @brief State at the start of a row, carried over from the closest state
+ * known before it. Rows passed on the way keep theirs every few lines, so
+ * scrolling tokenizes little more than what comes into view. Checkpoints are
+ * only ever appended, the kept states never go stale.
+ */
+int TextViewer::stateAt(const int r, bool &guessed)
+{
+    const int c = qMin(r / HIGHLIGHTER_CHECKPOINT_BLOCKS, _checkpoints.size() - 1);
+    guessed = (r - (c * HIGHLIGHTER_CHECKPOINT_BLOCKS)) > HIGHLIGHTER_CHECKPOINT_BLOCKS;
+    if (guessed)
+    {
+        return 0;
+    }
+    int from = c * HIGHLIGHTER_CHECKPOINT_BLOCKS;
+    int state = _checkpoints.at(c);
+    for (int k = r - (r % VIEWER_STATE_ROWS); k > from; k -= VIEWER_STATE_ROWS)
+    {
+        QHash<int, int>::const_iterator it = _states.constFind(k);
+        if (it != _states.constEnd())
+        {
+            from = k;
+            state = it.value();
+            break;
+        }
+    }
+    if (_states.size() > VIEWER_STATE_CACHE)
+    {
+        _states.clear();
+    }
+    CoderTokenList tokens;
+    for (int i = from; i < r; i++)
+    {
+        if (((i % VIEWER_STATE_ROWS) == 0) && (i != from))
+        {
+            _states.insert(i, state);
+        }
+        tokens.resize(0);
+        state = _tokenizer->tokenize(line(i), state, tokens);
+    }
+    if ((r % VIEWER_STATE_ROWS) == 0)
+    {
+        _states.insert(r, state);
+    }
+    return state;
+}
+
+void TextViewer::updateScrollBars()
+{
+    const int page = qMax(viewport()->height() / fontMetrics().height(), 1);
+    verticalScrollBar()->setPageStep(page);
+    verticalScrollBar()->setRange(0, qMax(rowCount() - page, 0));
+    horizontalScrollBar()->setPageStep(viewport()->width());
+    horizontalScrollBar()->setRange(0, qMax(_width + gutterWidth() - viewport()->width(), 0));
+    horizontalScrollBar()->setSingleStep(fontMetrics().width('8'));
+}
+
+TextViewer::~TextViewer()
+{
+    _file.close();
+}
+
+APP_NAMESPACE_END
@@ -0,0 +1,357 @@
+#include <algorithm>
+#include <QDir>
+#include "include/constants.h"
+#include "include/trigramindex.h"
+
+APP_NAMESPACE_START
+
+static inline uchar fold(const uchar c)
+{
+    return ((c >= 'A') && (c <= 'Z')) ? uchar(c + ('a' - 'A')) : c;
+}
+
+/**
+ * @brief Appends the trigrams of one literal run, folding ASCII case the way
+ * the indexer does and skipping any with bytes outside ASCII.
+ */
+static void collect(const QByteArray &run, QVector<quint32> &trigrams)
+{
+    for (int i = 0; (i + 2) < run.size(); i++)
+    {
+        const uchar a = fold(uchar(run.at(i)));
+        const uchar b = fold(uchar(run.at(i + 1)));
+        const uchar c = fold(uchar(run.at(i + 2)));
+        if ((a < 0x80) && (b < 0x80) && (c < 0x80))
+        {
+            const quint32 t = (quint32(a) << 16) | (quint32(b) << 8) | quint32(c);
+            if (!trigrams.contains(t))
+            {
+                trigrams << t;
+            }
+        }
+    }
+}
+
+TrigramIndex::TrigramIndex()
+    : _data(0), _files(0), _header(0), _trigrams(0)
+{
+}
+
+const TrigramIndex::Trigram *TrigramIndex::find(const quint32 t) const
+{
+    int low = 0;
+    int high = trigramCount() - 1;
+    while (low <= high)
+    {
+        const int middle = (low + high) / 2;
+        if (_trigrams[middle].trigram < t)
+        {
+            low = middle + 1;
+        }
+        else if (_trigrams[middle].trigram > t)
+        {
+            high = middle - 1;
+        }
+        else
+        {
+            return _trigrams + middle;
+        }
+    }
+    return 0;
+}
+
+QString TrigramIndex::filePath(const int id) const
+{
+    const File &f = _files[id];
+    return QString::fromUtf8(reinterpret_cast<const char *>(_data + _header->stringsOffset + f.path), int(f.length));
+}
+
+/**
+ * @brief Files that contain every one of the trigrams; all of them when there are none.
+ */
+QBitArray TrigramIndex::match(const QVector<quint32> &trigrams) const
+{
+    QBitArray files(fileCount(), trigrams.isEmpty());
+    QVector<const Trigram *> entries;
+    foreach (const quint32 t, trigrams)
+    {
+        const Trigram *entry = find(t);
+        if (!entry)
+        {
+            return QBitArray(fileCount(), false);
+        }
+        entries << entry;
+    }
+    // Shortest lists first, so the intersection shrinks as early as possible
+    std::sort(entries.begin(), entries.end(), [](const Trigram *a, const Trigram *b) { return a->count < b->count; });
+    for (int i = 0; i < entries.size(); i++)
+    {
+        QBitArray found(fileCount(), false);
+        foreach (const quint32 id, postings(int(entries.at(i) - _trigrams)))
+        {
+            if (id < quint32(fileCount()))
+            {
+                found.setBit(int(id));
+            }
+        }
+        files = (i == 0) ? found : (files & found);
+    }
+    return files;
+}
+
+bool TrigramIndex::open(const QString &project)
+{
+    _file.setFileName(path(project));
+    if (!_file.open(QIODevice::ReadOnly) || (_file.size() < qint64(sizeof(Header))))
+    {
+        return false;
+    }
+    _data = _file.map(0, _file.size());
+    const Header *h = reinterpret_cast<const Header *>(_data);
+    if (!_data
+            || (qstrncmp(h->magic, TRIGRAM_INDEX_MAGIC, 4) != 0)
+            || (h->version != TRIGRAM_INDEX_VERSION)
+            || (h->size != quint64(_file.size()))
+            || (h->filesOffset + (quint64(h->files) * sizeof(File)) > h->trigramsOffset)
+            || (h->trigramsOffset + (quint64(h->trigrams) * sizeof(Trigram)) > h->postingsOffset)
+            || (h->postingsOffset > h->stringsOffset)
+            || (h->stringsOffset > h->size))
+    {
+        _data = 0;
+        _file.close();
+        return false;
+    }
+    _header = h;
+    _files = reinterpret_cast<const File *>(_data + h->filesOffset);
+    _trigrams = reinterpret_cast<const Trigram *>(_data + h->trigramsOffset);
+    _paths.reserve(int(h->files));
+    const quint64 strings = h->size - h->stringsOffset;
+    for (int i = 0; i < fileCount(); i++)
+    {
+        // A corrupt path would be read past the mapping; the index is only a cache and gets rebuilt
+        if ((_files[i].path > strings) || (_files[i].length > (strings - _files[i].path)))
+        {
+            _paths.clear();
+            _files = 0;
+            _header = 0;
+            _trigrams = 0;
+            _data = 0;
+            _file.close();
+            return false;
+        }
+        _paths.insert(filePath(i), i);
+    }
+    return true;
+}
+
+QString TrigramIndex::path(const QString &project)
+{
+    return QDir(project).filePath(FILE_TRIGRAM_INDEX);
+}
+
+QVector<quint32> TrigramIndex::postings(const int index) const
+{
+    const Trigram &t = _trigrams[index];
+    QVector<quint32> ids;
+    if (t.postings > (_header->stringsOffset - _header->postingsOffset))
+    {
+        return ids;
+    }
+    const uchar *at = _data + _header->postingsOffset + t.postings;
+    const uchar *end = _data + _header->stringsOffset;
+    // Every id takes at least a byte, which bounds what a corrupt count can reserve
+    ids.reserve(int(qMin<quint64>(t.count, quint64(end - at))));
+    quint32 id = 0;
+    for (quint32 i = 0; (i < t.count) && (at < end); i++)
+    {
+        quint32 delta = 0;
+        int shift = 0;
+        while ((at < end) && (*at & 0x80))
+        {
+            delta |= quint32(*at++ & 0x7f) << shift;
+            shift += 7;
+        }
+        if (at < end)
+        {
+            delta |= quint32(*at++) << shift;
+        }
+        id += delta;
+        ids << id;
+    }
+    return ids;
+}
+
+/**
+ * @brief Index of the last character of an escape whose letter is at i, so
+ * operands like the "41" of \x41 or the "{L}" of \p{L} are not read as text.
+ */
+static int escapeEnd(const QString &text, int i)
+{
+    const QChar c = text.at(i);
+    if (((i + 1) < text.size()) && QString("{<'").contains(text.at(i + 1)) && QString("gkNopPx").contains(c))
+    {
+        const QChar open = text.at(i + 1);
+        const QChar close = (open == '{') ? QChar('}') : ((open == '<') ? QChar('>') : QChar('\''));
+        i++;
+        while (((i + 1) < text.size()) && (text.at(i) != close))
+        {
+            i++;
+        }
+        return i;
+    }
+    int digits = 0;
+    if ((c == 'c') || (c == 'p') || (c == 'P'))
+    {
+        digits = 1;
+    }
+    else if (c == 'x')
+    {
+        digits = 2;
+    }
+    else if (c == 'u')
+    {
+        digits = 4;
+    }
+    else if (c.isDigit())
+    {
+        digits = 2;
+    }
+    for (int n = 0; (n < digits) && ((i + 1) < text.size()); n++)
+    {
+        const QChar next = text.at(i + 1);
+        if ((c == 'c') || (c == 'p') || (c == 'P') || (c.isDigit() ? next.isDigit() : (next.isDigit() || QString("abcdefABCDEF").contains(next))))
+        {
+            i++;
+        }
+        else
+        {
+            break;
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief Trigrams every match of the search must contain. Regexes are read
+ * conservatively: alternations give nothing, and literals inside a group are
+ * only kept when the group itself cannot be skipped.
+ */
+QVector<quint32> TrigramIndex::required(const QString &text, const bool regex)
+{
+    QVector<quint32> trigrams;
+    if (!regex)
+    {
+        collect(text.toUtf8(), trigrams);
+        return trigrams;
+    }
+    if (text.contains('|') || text.contains("\\Q"))
+    {
+        return trigrams;
+    }
+    // One list per open group, plus whether that group may match nothing
+    QVector<QVector<quint32> > levels(1);
+    QVector<bool> optional(1, false);
+    QString run;
+    auto flush = [&run, &levels]() {
+        collect(run.toUtf8(), levels.last());
+        run.clear();
+    };
+    for (int i = 0; i < text.size(); i++)
+    {
+        const QChar c = text.at(i);
+        if ((c == '\\') && ((i + 1) < text.size()))
+        {
+            const QChar next = text.at(++i);
+            if (next.isLetterOrNumber())
+            {
+                // Classes like \d or \w, code points and backreferences
+                flush();
+                i = escapeEnd(text, i);
+            }
+            else
+            {
+                run.append(next);
+            }
+        }
+        else if (c == '(')
+        {
+            flush();
+            bool skippable = false;
+            if (((i + 1) < text.size()) && (text.at(i + 1) == '?'))
+            {
+                // Lookarounds, inline flags and the like are not matched text
+                skippable = !(((i + 2) < text.size()) && (text.at(i + 2) == ':'));
+                i += skippable ? 1 : 2;
+            }
+            levels << QVector<quint32>();
+            optional << skippable;
+        }
+        else if (c == ')')
+        {
+            flush();
+            if (levels.size() > 1)
+            {
+                const QVector<quint32> group = levels.takeLast();
+                bool skippable = optional.takeLast();
+                if ((i + 1) < text.size())
+                {
+                    const QChar next = text.at(i + 1);
+                    const QChar after = ((i + 2) < text.size()) ? text.at(i + 2) : QChar();
+                    skippable |= (next == '?') || (next == '*') || ((next == '{') && ((after == '0') || (after == ',')));
+                }
+                if (!skippable)
+                {
+                    foreach (const quint32 t, group)
+                    {
+                        if (!levels.last().contains(t))
+                        {
+                            levels.last() << t;
+                        }
+                    }
+                }
+            }
+        }
+        else if ((c == '?') || (c == '*') || (c == '{'))
+        {
+            // The previous character may not be there at all
+            run.chop(1);
+            flush();
+            if (c == '{')
+            {
+                while (((i + 1) < text.size()) && (text.at(i) != '}'))
+                {
+                    i++;
+                }
+            }
+        }
+        else if (c == '[')
+        {
+            flush();
+            while (((i + 1) < text.size()) && (text.at(++i) != ']'))
+            {
+                if (text.at(i) == '\\')
+                {
+                    i++;
+                }
+            }
+        }
+        else if (QString("^$.+").contains(c))
+        {
+            flush();
+        }
+        else
+        {
+            run.append(c);
+        }
+    }
+    flush();
+    // An unbalanced group makes the pattern invalid anyway
+    return (levels.size() == 1) ? levels.first() : trigrams;
+}
+
+TrigramIndex::~TrigramIndex()
+{
+    _file.close();
+}
+
+APP_NAMESPACE_END
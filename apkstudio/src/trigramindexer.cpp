@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <cstring>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include "include/constants.h"
+#include "include/trigramindexer.h"
+
+APP_NAMESPACE_START
+
+TrigramIndexer::TrigramIndexer(const CancelToken &t, const QString &p)
+    : QObject(0), _project(p), _seen(1 << 23), _token(t)
+{
+    setAutoDelete(false);
+}
+
+void TrigramIndexer::add(const quint32 t, const quint32 id)
+{
+    QHash<quint32, Postings>::iterator it = _postings.find(t);
+    if (it == _postings.end())
+    {
+        it = _postings.insert(t, Postings{QByteArray(), 0, 0});
+    }
+    quint32 delta = id - it->last;
+    while (delta >= 0x80)
+    {
+        it->data.append(char((delta & 0x7f) | 0x80));
+        delta >>= 7;
+    }
+    it->data.append(char(delta));
+    it->count++;
+    it->last = id;
+}
+
+void TrigramIndexer::run()
+{
+    struct Entry
+    {
+        QString path;
+        qint64 modified;
+        qint64 size;
+    };
+    const QDir root(_project);
+    const QStringList extensions = QString(EDITOR_EXT_CODER).split('|');
+    QVector<Entry> entries;
+    QDirIterator it(_project, QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext() && !_token->load())
+    {
+        it.next();
+        const QFileInfo info = it.fileInfo();
+        if (extensions.contains(info.suffix(), Qt::CaseInsensitive))
+        {
+            entries << Entry{root.relativeFilePath(info.filePath()), info.lastModified().toMSecsSinceEpoch(), info.size()};
+        }
+    }
+    QVector<TrigramIndex::File> files;
+    QByteArray strings;
+    QVector<int> changed;
+    bool stale = true;
+    auto append = [&files, &strings](const QString &path, const qint64 modified, const qint64 size) {
+        const QByteArray bytes = path.toUtf8();
+        files << TrigramIndex::File{modified, size, quint32(strings.size()), quint32(bytes.size())};
+        strings.append(bytes);
+    };
+    {
+        TrigramIndex old;
+        old.open(_project);
+        QVector<int> ids(old.fileCount(), -1);
+        for (int i = 0; i < entries.size(); i++)
+        {
+            const Entry &e = entries.at(i);
+            const int id = old.find(e.path);
+            if ((id >= 0) && (old.file(id).modified == e.modified) && (old.file(id).size == e.size))
+            {
+                ids[id] = 0;
+            }
+            else
+            {
+                changed << i;
+            }
+        }
+        // Unchanged files keep their relative order, so their postings stay sorted
+        for (int i = 0; i < ids.size(); i++)
+        {
+            if (ids.at(i) >= 0)
+            {
+                ids[i] = files.size();
+                append(old.filePath(i), old.file(i).modified, old.file(i).size);
+            }
+        }
+        stale = !changed.isEmpty() || (files.size() != old.fileCount());
+        if (stale && !files.isEmpty())
+        {
+            for (int i = 0; (i < old.trigramCount()) && !_token->load(); i++)
+            {
+                const quint32 t = old.trigram(i);
+                foreach (const quint32 id, old.postings(i))
+                {
+                    if ((id < quint32(ids.size())) && (ids.at(int(id)) >= 0))
+                    {
+                        add(t, quint32(ids.at(int(id))));
+                    }
+                }
+            }
+        }
+    }
+    foreach (const int i, changed)
+    {
+        if (_token->load())
+        {
+            break;
+        }
+        const Entry &e = entries.at(i);
+        scan(root.filePath(e.path), quint32(files.size()));
+        append(e.path, e.modified, e.size);
+    }
+    if (stale && !_token->load())
+    {
+        write(files, strings);
+    }
+    emit finished(_project);
+}
+
+void TrigramIndexer::scan(const QString &path, const quint32 id)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        return;
+    }
+    QByteArray buffer;
+    const uchar *data = file.size() ? file.map(0, file.size()) : 0;
+    qint64 size = file.size();
+    if (!data)
+    {
+        buffer = file.readAll();
+        data = reinterpret_cast<const uchar *>(buffer.constData());
+        size = buffer.size();
+    }
+    QVector<quint32> found;
+    quint32 t = 0;
+    int valid = 0;
+    for (qint64 i = 0; i < size; i++)
+    {
+        uchar c = data[i];
+        if ((c >= 0x80) || (c == '\n') || (c == '\r'))
+        {
+            valid = 0;
+            continue;
+        }
+        if ((c >= 'A') && (c <= 'Z'))
+        {
+            c += 'a' - 'A';
+        }
+        t = ((t << 8) | c) & 0xffffff;
+        if ((++valid >= 3) && !_seen.testBit(int(t)))
+        {
+            _seen.setBit(int(t));
+            found << t;
+        }
+    }
+    foreach (const quint32 trigram, found)
+    {
+        add(trigram, id);
+        _seen.clearBit(int(trigram));
+    }
+}
+
+/**
+ * @brief Writes the index in native byte order; it is a local cache and is
+ * rebuilt whenever the header does not check out.
+ */
+bool TrigramIndexer::write(const QVector<TrigramIndex::File> &files, const QByteArray &strings)
+{
+    QList<quint32> keys = _postings.keys();
+    std::sort(keys.begin(), keys.end());
+    QVector<TrigramIndex::Trigram> trigrams;
+    trigrams.reserve(keys.size());
+    quint64 postings = 0;
+    foreach (const quint32 t, keys)
+    {
+        const Postings &p = _postings[t];
+        trigrams << TrigramIndex::Trigram{t, p.count, postings};
+        postings += quint64(p.data.size());
+    }
+    TrigramIndex::Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TRIGRAM_INDEX_MAGIC, 4);
+    header.version = TRIGRAM_INDEX_VERSION;
+    header.files = quint32(files.size());
+    header.trigrams = quint32(trigrams.size());
+    header.filesOffset = sizeof(header);
+    header.trigramsOffset = header.filesOffset + (quint64(files.size()) * sizeof(TrigramIndex::File));
+    header.postingsOffset = header.trigramsOffset + (quint64(trigrams.size()) * sizeof(TrigramIndex::Trigram));
+    header.stringsOffset = header.postingsOffset + postings;
+    header.size = header.stringsOffset + quint64(strings.size());
+    QSaveFile file(TrigramIndex::path(_project));
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(files.constData()), files.size() * sizeof(TrigramIndex::File));
+    file.write(reinterpret_cast<const char *>(trigrams.constData()), trigrams.size() * sizeof(TrigramIndex::Trigram));
+    foreach (const quint32 t, keys)
+    {
+        file.write(_postings[t].data);
+    }
+    file.write(strings);
+    return file.commit();
+}
+
+APP_NAMESPACE_END
@@ -41,7 +41,7 @@ UberApkSigner *UberApkSigner::get()
 
 Process::Result UberApkSigner::exec(const QStringList &a)
 {
-    return Java::exec(QStringList("-jar") << _jar << a);
+    return execJar(_jar, a);
 }
 
 
@@ -0,0 +1,16 @@
+#include "include/versionprobe.h"
+
+APP_NAMESPACE_START
+
+VersionProbe::VersionProbe(const int t, const std::function<QString()> &p)
+    : QObject(0), _probe(p), _tool(t)
+{
+    setAutoDelete(false);
+}
+
+void VersionProbe::run()
+{
+    emit probed(_tool, _probe());
+}
+
+APP_NAMESPACE_END
@@ -0,0 +1,279 @@
+#include <cstring>
+#include <QBuffer>
+#include <QtEndian>
+#include <zlib.h>
+#include "include/constants.h"
+#include "include/zipreader.h"
+
+APP_NAMESPACE_START
+
+static inline quint16 u16(const uchar *p)
+{
+    return qFromLittleEndian<quint16>(p);
+}
+
+static inline quint32 u32(const uchar *p)
+{
+    return qFromLittleEndian<quint32>(p);
+}
+
+static inline quint64 u64(const uchar *p)
+{
+    return qFromLittleEndian<quint64>(p);
+}
+
+/**
+ * @brief Whether length bytes from at lie within size, without letting the
+ * untrusted 64 bit values wrap around.
+ */
+static inline bool fits(const quint64 at, const quint64 length, const quint64 size)
+{
+    return (at <= size) && (length <= (size - at));
+}
+
+ZipReader::ZipReader()
+    : _data(0), _size(0)
+{
+}
+
+/**
+ * @brief Bytes of a stored entry right in the mapped archive; compressed
+ * entries have to be read.
+ */
+const uchar *ZipReader::data(const int i) const
+{
+    const Entry &e = _entries.at(i);
+    return (e.method == 0) ? payload(e) : 0;
+}
+
+/**
+ * @brief Streams the entry into the device, checking its CRC on the way.
+ */
+bool ZipReader::extract(const int i, QIODevice *out) const
+{
+    const Entry &e = _entries.at(i);
+    const uchar *in = payload(e);
+    if (!in)
+    {
+        return false;
+    }
+    uLong crc = crc32(0L, Z_NULL, 0);
+    if (e.method == 0)
+    {
+        for (quint64 done = 0; done < e.size; done += ZIP_CHUNK)
+        {
+            const uInt n = uInt(qMin<quint64>(ZIP_CHUNK, e.size - done));
+            crc = crc32(crc, in + done, n);
+            if (out->write(reinterpret_cast<const char *>(in + done), n) != qint64(n))
+            {
+                return false;
+            }
+        }
+        return crc == e.crc;
+    }
+    if (e.method != Z_DEFLATED)
+    {
+        return false;
+    }
+    z_stream z;
+    memset(&z, 0, sizeof(z));
+    if (inflateInit2(&z, -MAX_WBITS) != Z_OK)
+    {
+        return false;
+    }
+    QByteArray buffer(ZIP_CHUNK, Qt::Uninitialized);
+    quint64 consumed = 0;
+    int status = Z_OK;
+    while (status == Z_OK)
+    {
+        if (z.avail_in == 0)
+        {
+            // Fed in slices too, avail_in is only 32 bits wide
+            const uInt n = uInt(qMin<quint64>(ZIP_CHUNK, e.compressed - consumed));
+            z.next_in = const_cast<Bytef *>(in + consumed);
+            z.avail_in = n;
+            consumed += n;
+        }
+        z.next_out = reinterpret_cast<Bytef *>(buffer.data());
+        z.avail_out = uInt(buffer.size());
+        status = inflate(&z, Z_NO_FLUSH);
+        const uInt n = uInt(buffer.size()) - z.avail_out;
+        if (((status == Z_OK) || (status == Z_STREAM_END)) && n)
+        {
+            crc = crc32(crc, reinterpret_cast<const Bytef *>(buffer.constData()), n);
+            if (out->write(buffer.constData(), n) != qint64(n))
+            {
+                status = Z_ERRNO;
+            }
+        }
+        if ((status == Z_OK) && (z.avail_in == 0) && (consumed >= e.compressed) && (z.avail_out != 0))
+        {
+            status = Z_DATA_ERROR;
+        }
+    }
+    inflateEnd(&z);
+    return (status == Z_STREAM_END) && (crc == e.crc);
+}
+
+int ZipReader::find(const QString &n) const
+{
+    for (int i = 0; i < _entries.size(); i++)
+    {
+        if (_entries.at(i).name == n)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool ZipReader::open(const QString &p)
+{
+    _entries.clear();
+    _file.close();
+    _file.setFileName(p);
+    if (!_file.open(QIODevice::ReadOnly) || (_file.size() < 22))
+    {
+        return false;
+    }
+    _size = quint64(_file.size());
+    _data = _file.map(0, _file.size());
+    if (!_data || !parse())
+    {
+        _entries.clear();
+        _file.close();
+        _data = 0;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Finds the end of central directory record from the back, following
+ * the ZIP64 locator when the 32 bit fields are saturated.
+ */
+bool ZipReader::parse()
+{
+    qint64 eocd = -1;
+    const qint64 last = qint64(_size) - 22;
+    for (qint64 i = last; (i >= 0) && (i >= (last - 0xffff)); i--)
+    {
+        if ((_data[i] == 'P') && (u32(_data + i) == 0x06054b50))
+        {
+            eocd = i;
+            break;
+        }
+    }
+    if (eocd < 0)
+    {
+        return false;
+    }
+    quint64 count = u16(_data + eocd + 10);
+    quint64 offset = u32(_data + eocd + 16);
+    if ((eocd >= 20) && (u32(_data + eocd - 20) == 0x07064b50))
+    {
+        const quint64 record = u64(_data + eocd - 20 + 8);
+        if (fits(record, 56, _size) && (u32(_data + record) == 0x06064b50))
+        {
+            count = u64(_data + record + 32);
+            offset = u64(_data + record + 48);
+        }
+    }
+    if (count > (_size / 46))
+    {
+        return false;
+    }
+    _entries.reserve(int(count));
+    quint64 at = offset;
+    for (quint64 n = 0; n < count; n++)
+    {
+        if (!fits(at, 46, _size) || (u32(_data + at) != 0x02014b50))
+        {
+            return false;
+        }
+        const uchar *h = _data + at;
+        const quint16 nameLength = u16(h + 28);
+        const quint16 extraLength = u16(h + 30);
+        const quint16 commentLength = u16(h + 32);
+        if (!fits(at, 46 + nameLength + extraLength + commentLength, _size))
+        {
+            return false;
+        }
+        Entry e;
+        e.method = u16(h + 10);
+        e.crc = u32(h + 16);
+        e.compressed = u32(h + 20);
+        e.size = u32(h + 24);
+        e.offset = u32(h + 42);
+        e.name = QString::fromUtf8(reinterpret_cast<const char *>(h + 46), nameLength);
+        const uchar *extra = h + 46 + nameLength;
+        for (int x = 0; (x + 4) <= extraLength; )
+        {
+            const quint16 id = u16(extra + x);
+            const quint16 length = u16(extra + x + 2);
+            if ((x + 4 + length) > extraLength)
+            {
+                break;
+            }
+            if (id == 0x0001)
+            {
+                // Only the saturated fields are present, in this order
+                const uchar *f = extra + x + 4;
+                const uchar *end = f + length;
+                if ((e.size == 0xffffffff) && ((f + 8) <= end))
+                {
+                    e.size = u64(f);
+                    f += 8;
+                }
+                if ((e.compressed == 0xffffffff) && ((f + 8) <= end))
+                {
+                    e.compressed = u64(f);
+                    f += 8;
+                }
+                if ((e.offset == 0xffffffff) && ((f + 8) <= end))
+                {
+                    e.offset = u64(f);
+                }
+            }
+            x += 4 + length;
+        }
+        if (!e.name.endsWith('/'))
+        {
+            _entries << e;
+        }
+        at += 46 + nameLength + extraLength + commentLength;
+    }
+    return true;
+}
+
+/**
+ * @brief Start of the entry's data past its local header, or nothing when it
+ * does not fit in the file.
+ */
+const uchar *ZipReader::payload(const Entry &e) const
+{
+    if (!_data || !fits(e.offset, 30, _size) || (u32(_data + e.offset) != 0x04034b50))
+    {
+        return 0;
+    }
+    const quint64 header = 30 + u16(_data + e.offset + 26) + u16(_data + e.offset + 28);
+    const quint64 length = (e.method == 0) ? e.size : e.compressed;
+    if (!fits(e.offset, header, _size) || !fits(e.offset + header, length, _size))
+    {
+        return 0;
+    }
+    return _data + e.offset + header;
+}
+
+QByteArray ZipReader::read(const int i) const
+{
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    // The declared size is untrusted, so the reserve is bounded by what the compressed bytes could plausibly inflate to
+    const Entry &e = _entries.at(i);
+    data.reserve(int(qMin<quint64>(e.size, qMin<quint64>(e.compressed, ZIP_RESERVE_MAX / ZIP_RESERVE_RATIO) * ZIP_RESERVE_RATIO)));
+    return extract(i, &buffer) ? data : QByteArray();
+}
+
+APP_NAMESPACE_END
@@ -0,0 +1,18 @@
+QT += core testlib
+QT -= gui
+
+CONFIG += c++11 console testcase
+CONFIG -= app_bundle
+
+INCLUDEPATH += ..
+
+HEADERS += \
+    ../include/trigramindex.h
+
+SOURCES += \
+    ../src/trigramindex.cpp \
+    tst_trigramindex.cpp
+
+TARGET = tst_trigramindex
+
+TEMPLATE = app
@@ -0,0 +1,47 @@
+#include <QtTest>
+#include "include/trigramindex.h"
+
+using namespace APP_NAMESPACE;
+
+class TestTrigramIndex : public QObject
+{
+    Q_OBJECT
+private:
+    static QVector<quint32> trigrams(const QStringList &runs)
+    {
+        QVector<quint32> t;
+        foreach (const QString &r, runs)
+        {
+            const QByteArray b = r.toLatin1();
+            t << ((quint32(uchar(b.at(0))) << 16) | (quint32(uchar(b.at(1))) << 8) | quint32(uchar(b.at(2))));
+        }
+        return t;
+    }
+private Q_SLOTS:
+    void required_data()
+    {
+        QTest::addColumn<QString>("pattern");
+        QTest::addColumn<QStringList>("expected");
+        QTest::newRow("optional group") << "(abc)?def" << (QStringList() << "def");
+        QTest::newRow("starred group") << "(?:foo)*bar" << (QStringList() << "bar");
+        QTest::newRow("zero repeat group") << "(abc){0,2}x" << QStringList();
+        QTest::newRow("repeated group") << "(abc)+xyz" << (QStringList() << "abc" << "xyz");
+        QTest::newRow("nested group") << "foo(bar(baz)?)qux" << (QStringList() << "foo" << "bar" << "qux");
+        QTest::newRow("lookahead") << "(?=abc)def" << (QStringList() << "def");
+        QTest::newRow("hex escape") << "\\x41bcd" << (QStringList() << "bcd");
+        QTest::newRow("braced hex escape") << "\\x{263a}abc" << (QStringList() << "abc");
+        QTest::newRow("unicode escape") << "\\u0041bcd" << (QStringList() << "bcd");
+        QTest::newRow("property escape") << "\\p{L}bcd" << (QStringList() << "bcd");
+        QTest::newRow("alternation") << "foo|bar" << QStringList();
+    }
+    void required()
+    {
+        QFETCH(QString, pattern);
+        QFETCH(QStringList, expected);
+        QCOMPARE(TrigramIndex::required(pattern, true), trigrams(expected));
+    }
+};
+
+QTEST_APPLESS_MAIN(TestTrigramIndex)
+
+#include "tst_trigramindex.moc"